@@ -17,15 +17,20 @@
  */
 #include <SPI.h>
 #include <Gamebuino.h>
+#include <EEPROM.h>
+
+#include "DarkTowerText.h"
+#include "DarkTowerRooms.h"
 
 #define EVENT_MEMORY 2
-#define DESCRIPTION_SIZE 250
+#define EVENT_HISTORY_DEPTH 16
+#define DESCRIPTION_MAX_TEXTS 4
+#define DESCRIPTION_MAX_LINES 32
 
 #define MAX_OBJECTS_PER_EVENT 10
 #define MAX_OBJECTS_ON_PLAYER MAX_OBJECTS_PER_EVENT
 
 #define OBJECT_MENU_LENGTH (MAX_OBJECTS_ON_PLAYER)
-#define OBJECT_MENU_ITEM_LENGTH 13
 
 typedef unsigned char action_id;
 
@@ -48,6 +53,21 @@ typedef unsigned char event_tag_id;
 
 #define EVENT_TAG_ID_ALL		 				(0xff)
 
+typedef unsigned char event_type_id;
+
+#define EVENT_TYPE_ID_NOTHING 0
+#define EVENT_TYPE_ID_INTRO 1
+#define EVENT_TYPE_ID_RESURRECT 2
+#define EVENT_TYPE_ID_RETURN_TO_GAME 3
+#define EVENT_TYPE_ID_WIN 4
+#define EVENT_TYPE_ID_PLAYER_DIES 5
+#define EVENT_TYPE_ID_DRINKS_YELLOW_VIAL 6
+#define EVENT_TYPE_ID_F0_MONSTER_DIES 7
+#define EVENT_TYPE_ID_F4_DOOR_UNLOCKED 8
+// Each room in DarkTowerRooms.h is its own type, from here on in ROOM_ID order.
+#define EVENT_TYPE_ID_FIRST_ROOM 9
+#define EVENT_TYPE_ID_COUNT (EVENT_TYPE_ID_FIRST_ROOM + ROOM_COUNT)
+
 typedef unsigned char game_state_id;
 
 #define GAME_STATE_ID_TITLE 0
@@ -71,51 +91,748 @@ extern const byte font3x5[];
 typedef void (*basic_function)();
 typedef void (*load_string_function)(char *string_to_init);
 
-typedef unsigned int player_item_id;
-
-#define PLAYER_ITEM_ID_MASTER_KEY		(1 << 0)
-#define PLAYER_ITEM_ID_OIL_LAMP			(1 << 1)
-#define PLAYER_ITEM_ID_SWORD			(1 << 2)
-#define PLAYER_ITEM_ID_BROKEN_KEY		(1 << 3)
-#define PLAYER_ITEM_ID_BLANK_KEY		(1 << 4)
-#define PLAYER_ITEM_ID_MOD_CHEST_KEY	(1 << 5)
-#define PLAYER_ITEM_ID_SHEET			(1 << 6)
-#define PLAYER_ITEM_ID_COPIED_KEY		(1 << 7)
-#define PLAYER_ITEM_ID_CHEST_KEY		(1 << 8)
-#define PLAYER_ITEM_ID_ROPE				(1 << 9)
-
-#define PLAYER_ITEM_ID_ALL 				(0xffff)
-
-const char player_item_name_master_key[] PROGMEM = "Crystal";
-const char player_item_name_lamp[] PROGMEM = "Lamp";
-const char player_item_name_broad_sword[] PROGMEM = "Silver Sword";
-const char player_item_name_broken_key[] PROGMEM = "Broken Key";
-const char player_item_name_blank_key[] PROGMEM = "Blank Key";
-const char player_item_name_modified_chest_key[] PROGMEM = "Modified Key";
-const char player_item_name_sheet[] PROGMEM = "Curtain";
-const char player_item_name_copied_key[] PROGMEM = "Copied Key";
-const char player_item_name_chest_key[] PROGMEM = "Copper Key";
-const char player_item_name_rope[] PROGMEM = "Rope";
-
-const char* const player_item_name_full_list[] PROGMEM =
-	{ player_item_name_master_key
-	, player_item_name_lamp
-	, player_item_name_broad_sword
-	, player_item_name_broken_key
-	, player_item_name_blank_key
-	, player_item_name_modified_chest_key
-	, player_item_name_sheet
-	, player_item_name_copied_key
-	, player_item_name_chest_key
-	, player_item_name_rope
+#ifdef DARK_TOWER_PROFILE
+
+// ------------------------------------------------
+// Profiling
+// ------------------------------------------------
+
+// Built with DARK_TOWER_PROFILE defined, the sketch times the sections below
+// and its frames in CPU cycles, and every PROFILE_REPORT_FRAMES frames sends a
+// report of them over Serial for tools/decode_profile.py. A report, with
+// every number little-endian, is
+//
+//   PROFILE_REPORT_MAGIC
+//   uint16_t frames, uint32_t cycles per frame-time bucket
+//   uint8_t bucket count, then a uint16_t count of frames in each bucket
+//   uint8_t section count, then for each section:
+//     uint16_t calls, uint32_t min, max and total cycles
+//
+// A frame's time is the sketch's own work on a frame of play, after
+// gb.update(). The last bucket holds every frame that overran the frame rate.
+// Built without it, PROFILE_SCOPE is empty and none of this is compiled.
+
+#ifdef DARK_TOWER_RECORD_INPUT
+#error "DARK_TOWER_PROFILE and DARK_TOWER_RECORD_INPUT both use Serial"
+#endif
+
+#define PROFILE_REPORT_MAGIC "DTP1"
+#define PROFILE_REPORT_FRAMES 100
+#define PROFILE_FRAME_BUCKETS 8
+#define PROFILE_FRAME_BUCKET_CYCLES (F_CPU / NUM_FRAMES_PER_SECOND / (PROFILE_FRAME_BUCKETS - 1))
+
+// Named as tools/decode_profile.py prints them.
+#define PROFILE_SECTION_UPDATE_DISPLAY 0
+#define PROFILE_SECTION_DISPLAY_PORTION 1
+#define PROFILE_SECTION_PRINT_MENU 2
+#define PROFILE_SECTION_LOAD_EVENT 3
+#define PROFILE_SECTION_PROCESS_ACTION 4
+#define PROFILE_SECTION_PROCESS_ITEM 5
+#define PROFILE_SECTION_COUNT 6
+
+#ifdef __AVR__
+
+volatile uint16_t profile_clock_overflows = 0;
+
+ISR(TIMER1_OVF_vect){
+	profile_clock_overflows++;
+}
+
+// Timer 1 counts every cycle, and its overflows extend it to 32 bits.
+void start_profile_clock(){
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);
+	TCNT1 = 0;
+	TIMSK1 = _BV(TOIE1);
+}
+
+uint32_t read_profile_clock(){
+	uint8_t old_sreg = SREG;
+	cli();
+	uint16_t count = TCNT1;
+	uint16_t overflows = profile_clock_overflows;
+	// An overflow not yet handled has already wrapped a low count.
+	if ((TIFR1 & _BV(TOV1)) && count < 0x8000)
+		overflows++;
+	SREG = old_sreg;
+	return ((uint32_t)overflows << 16) | count;
+}
+
+#else
+
+#include <gamebuino_host.h>
+
+void start_profile_clock(){
+}
+
+uint32_t read_profile_clock(){
+	return host_get_cycles();
+}
+
+#endif
+
+struct profile_section_type
+{
+	uint16_t calls;
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+	uint32_t total_cycles;
+};
+
+class profiler_type {
+public:
+	void begin(){
+		start_profile_clock();
+		reset();
+	}
+
+	void add(uint8_t section_index, uint32_t cycles){
+		profile_section_type& section = sections[section_index];
+		section.calls++;
+		section.total_cycles += cycles;
+		if (cycles < section.min_cycles)
+			section.min_cycles = cycles;
+		if (cycles > section.max_cycles)
+			section.max_cycles = cycles;
+	}
+
+	void start_frame(){
+		frame_start = read_profile_clock();
+	}
+
+	void end_frame(){
+		uint32_t bucket = (read_profile_clock() - frame_start) / PROFILE_FRAME_BUCKET_CYCLES;
+		frame_buckets[bucket < PROFILE_FRAME_BUCKETS ? bucket : PROFILE_FRAME_BUCKETS - 1]++;
+
+		if (++frames == PROFILE_REPORT_FRAMES){
+			send_report();
+			reset();
+		}
+	}
+
+private:
+	profile_section_type sections[PROFILE_SECTION_COUNT];
+	uint16_t frame_buckets[PROFILE_FRAME_BUCKETS];
+	uint16_t frames;
+	uint32_t frame_start;
+
+	void reset(){
+		memset(sections, 0, sizeof(sections));
+		for (uint8_t i = 0; i < PROFILE_SECTION_COUNT; i++)
+			sections[i].min_cycles = UINT32_MAX;
+		memset(frame_buckets, 0, sizeof(frame_buckets));
+		frames = 0;
+	}
+
+	void send(uint32_t value, uint8_t size){
+		for (; size > 0; size--, value >>= 8)
+			Serial.write(value & 0xff);
+	}
+
+	void send_report(){
+		Serial.write(PROFILE_REPORT_MAGIC);
+		send(frames, 2);
+		send(PROFILE_FRAME_BUCKET_CYCLES, 4);
+		send(PROFILE_FRAME_BUCKETS, 1);
+		for (uint8_t i = 0; i < PROFILE_FRAME_BUCKETS; i++)
+			send(frame_buckets[i], 2);
+		send(PROFILE_SECTION_COUNT, 1);
+		for (uint8_t i = 0; i < PROFILE_SECTION_COUNT; i++){
+			send(sections[i].calls, 2);
+			send(sections[i].calls ? sections[i].min_cycles : 0, 4);
+			send(sections[i].max_cycles, 4);
+			send(sections[i].total_cycles, 4);
+		}
+	}
+} profiler;
+
+// Times the rest of the block it is declared in.
+class profile_scope_type {
+public:
+	profile_scope_type(uint8_t new_section)
+	: section( new_section )
+	, start( read_profile_clock() )
+	{ }
+
+	~profile_scope_type(){
+		profiler.add(section, read_profile_clock() - start);
+	}
+
+private:
+	uint8_t section;
+	uint32_t start;
+};
+
+#define PROFILE_SCOPE(section) profile_scope_type profile_scope(section)
+
+#else
+
+#define PROFILE_SCOPE(section)
+
+#endif
+
+// ------------------------------------------------
+// Text drawing
+// ------------------------------------------------
+
+// The font all the game's text is drawn in, and the size of its characters
+// with the blank column and row after them, as gb.display.setFont() counts it.
+#define TEXT_FONT font5x7
+#define TEXT_FONT_WIDTH (pgm_read_byte(TEXT_FONT) + 1)
+#define TEXT_FONT_HEIGHT (pgm_read_byte(TEXT_FONT + 1) + 1)
+
+#ifdef DARK_TOWER_PROPORTIONAL_FONT
+
+// Built with DARK_TOWER_PROPORTIONAL_FONT defined, each glyph is drawn only as
+// wide as its ink, and a blank column, so more text fits on a line. Text is
+// then measured in pixels from text_glyph_spans, a byte for each printable
+// character with the first column of TEXT_FONT's glyph drawn in the high
+// nibble and how many are drawn in the low. The space is three blank
+// columns, leaving room for the menu's selection box. Text is drawn at font
+// size 1, and never wraps by itself.
+#define TEXT_GLYPH_SPAN(first_column, column_count) (((first_column) << 4) | (column_count))
+#define TEXT_FIRST_GLYPH ' '
+#define TEXT_LAST_GLYPH '~'
+
+const uint8_t text_glyph_spans[TEXT_LAST_GLYPH - TEXT_FIRST_GLYPH + 1] PROGMEM = {
+	0x03, 0x21, 0x13, 0x05, 0x05, 0x05, 0x05, 0x13, 0x13, 0x13, 0x05, 0x05, 0x13, 0x05, 0x22, 0x05, //  !"#$%&'()*+,-./
+	0x05, 0x13, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x21, 0x12, 0x14, 0x05, 0x14, 0x05, // 0123456789:;<=>?
+	0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x13, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, // @ABCDEFGHIJKLMNO
+	0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x14, 0x05, 0x14, 0x05, 0x05, // PQRSTUVWXYZ[\]^_
+	0x13, 0x05, 0x05, 0x05, 0x05, 0x05, 0x14, 0x05, 0x05, 0x13, 0x04, 0x04, 0x13, 0x05, 0x05, 0x05, // `abcdefghijklmno
+	0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x13, 0x21, 0x13, 0x05 // pqrstuvwxyz{|}~
+	};
+
+uint8_t get_glyph_span(uint8_t c){
+	if (c < TEXT_FIRST_GLYPH || c > TEXT_LAST_GLYPH)
+		return TEXT_GLYPH_SPAN(0, TEXT_FONT_WIDTH - 1);
+	return pgm_read_byte(&text_glyph_spans[c - TEXT_FIRST_GLYPH]);
+}
+
+// The pixels a character moves the cursor on by.
+uint8_t char_width(uint8_t c){
+	return (get_glyph_span(c) & 0x0f) + 1;
+}
+
+uint16_t progmem_chars_width(const char *chars, uint8_t length){
+	uint16_t width = 0;
+	for (uint8_t i = 0; i < length; i++)
+		width += char_width(pgm_read_byte(chars + i));
+	return width;
+}
+
+// Draws the columns of a glyph that are not all on one byte row, pixel by
+// pixel, as gb.display.drawChar() would.
+void draw_glyph_pixels(int8_t x, int8_t y, const uint8_t *glyph, uint8_t column_count){
+	Display& display = gb.display;
+	int8_t glyph_color = display.color;
+
+	for (uint8_t i = 0; i <= column_count; i++){
+		uint8_t line = i < column_count ? pgm_read_byte(glyph + i) : 0;
+		for (uint8_t j = 0; j < TEXT_FONT_HEIGHT; j++, line >>= 1){
+			if (line & 0x1)
+				display.color = glyph_color;
+			else if (display.bgcolor != glyph_color)
+				display.color = display.bgcolor;
+			else
+				continue;
+			display.drawPixel(x + i, y + j);
+		}
+	}
+	display.color = glyph_color;
+}
+
+#else
+
+uint8_t char_width(uint8_t){
+	return gb.display.fontWidth;
+}
+
+uint16_t progmem_chars_width(const char *, uint8_t length){
+	return length * gb.display.fontWidth;
+}
+
+#endif
+
+// Draws a character at the display's cursor and moves the cursor on, wrapping
+// as gb.display.write() does. A glyph that sits on a byte row of the frame
+// buffer, in black over white, is written a column byte at a time from
+// TEXT_FONT, as long as the display is set to a font of its size; anywhere
+// else it is drawn pixel by pixel.
+void draw_char(uint8_t c){
+	Display& display = gb.display;
+	int8_t x = display.cursorX;
+	int8_t y = display.cursorY;
+#ifdef DARK_TOWER_PROPORTIONAL_FONT
+	uint8_t span = get_glyph_span(c);
+	uint8_t first_column = span >> 4;
+	uint8_t column_count = span & 0x0f;
+#else
+	uint8_t first_column = 0;
+	uint8_t column_count = TEXT_FONT_WIDTH - 1;
+#endif
+	const uint8_t *glyph = TEXT_FONT + 2 + c * (TEXT_FONT_WIDTH - 1) + first_column;
+
+	if ((y & 7) == 0 && y >= 0 && y < LCDHEIGHT && x >= 0 && x + column_count < LCDWIDTH
+		&& display.fontSize == 1 && display.fontWidth == TEXT_FONT_WIDTH
+		&& display.fontHeight == TEXT_FONT_HEIGHT && TEXT_FONT_HEIGHT <= 8
+		&& display.color == BLACK && display.bgcolor == WHITE && !(c & 0x80)){
+		uint8_t *column = display.getBuffer() + x + (y >> 3) * LCDWIDTH;
+		uint8_t mask = 0xff >> (8 - TEXT_FONT_HEIGHT);
+
+		for (uint8_t i = 0; i < column_count; i++)
+			column[i] = (column[i] & ~mask) | (pgm_read_byte(glyph + i) & mask);
+		column[column_count] &= ~mask;
+	}
+#ifdef DARK_TOWER_PROPORTIONAL_FONT
+	else
+		draw_glyph_pixels(x, y, glyph, column_count);
+
+	// Stays clear of the overflow of cursorX.
+	if (x < LCDWIDTH)
+		display.cursorX += column_count + 1;
+#else
+	else
+		display.drawChar(x, y, c, display.fontSize);
+
+	display.cursorX += display.fontSize * display.fontWidth;
+	if (display.textWrap && (display.cursorX > (LCDWIDTH - display.fontSize * display.fontWidth))){
+		display.cursorY += display.fontSize * display.fontHeight;
+		display.cursorX = 0;
+	}
+#endif
+}
+
+void draw_progmem_chars(const char *chars, uint8_t length){
+	for (uint8_t i = 0; i < length; i++)
+		draw_char(pgm_read_byte(chars + i));
+}
+
+// ------------------------------------------------
+// Text
+// ------------------------------------------------
+
+// Walks a compressed text from DarkTowerText.h one word at a time. Words are
+// separated by single spaces; extra spaces come out as empty words.
+class text_reader_type {
+public:
+	text_reader_type(text_id text)
+	: next_code( text_streams + text )
+	, word( NULL )
+	, word_length( 0 )
+	, started( false )
+	, word_follows_space( false )
+	{ }
+
+	bool next_word(){
+		uint8_t code = pgm_read_byte(next_code);
+		if (code == TEXT_CODE_END)
+			return false;
+		next_code++;
+
+		if (code <= TEXT_CODE_LITERAL_MAX){
+			word = (const char*)next_code;
+			word_length = code;
+			next_code += code;
+		}
+		else if (code == TEXT_CODE_EMPTY_WORD)
+			word_length = 0;
+		else {
+			uint16_t index = code - TEXT_CODE_WORD;
+			if (code >= TEXT_CODE_LONG_WORD)
+				index = TEXT_SHORT_WORD_CODES + (((code - TEXT_CODE_LONG_WORD) << 8) | pgm_read_byte(next_code++));
+			uint16_t word_start = pgm_read_word(&text_dictionary_offsets[index]);
+			word = text_dictionary + word_start;
+			word_length = pgm_read_word(&text_dictionary_offsets[index + 1]) - word_start;
+		}
+
+		word_follows_space = started;
+		started = true;
+		return true;
+	}
+
+	bool follows_space(){
+		return word_follows_space;
+	}
+
+	// The offset of the next word's code, from which a reader can resume.
+	text_id get_position(){
+		return next_code - text_streams;
+	}
+
+	uint8_t get_word_length(){
+		return word_length;
+	}
+
+	uint16_t get_word_width(){
+		return progmem_chars_width(word, word_length);
+	}
+
+	void copy_word(char *dest, uint8_t length){
+		memcpy_P(dest, word, length);
+	}
+
+	void draw_word(){
+		draw_progmem_chars(word, word_length);
+	}
+
+private:
+	const uint8_t *next_code;
+	const char *word;
+	uint8_t word_length;
+	bool started;
+	bool word_follows_space;
+};
+
+// Writes at most max_length characters of the text to dest, then a terminator.
+uint8_t expand_text(text_id text, char *dest, uint8_t max_length){
+	text_reader_type reader(text);
+	uint8_t length = 0;
+
+	while (reader.next_word()){
+		if (reader.follows_space() && length < max_length)
+			dest[length++] = ' ';
+
+		uint8_t word_length = reader.get_word_length();
+		if (word_length > max_length - length)
+			word_length = max_length - length;
+		reader.copy_word(dest + length, word_length);
+		length += word_length;
+	}
+	dest[length] = '\0';
+	return length;
+}
+
+// The pixels a text is drawn across.
+uint16_t text_width(text_id text){
+	text_reader_type reader(text);
+	uint16_t width = 0;
+
+	while (reader.next_word()){
+		if (reader.follows_space())
+			width += char_width(' ');
+		width += reader.get_word_width();
+	}
+	return width;
+}
+
+void draw_text(text_id text){
+	text_reader_type reader(text);
+
+	while (reader.next_word()){
+		if (reader.follows_space())
+			draw_char(' ');
+		reader.draw_word();
+	}
+}
+
+// A place in a description: one of its texts, and an offset into text_streams.
+struct description_position_type
+{
+	uint8_t text_index;
+	text_id code;
+};
+
+// An event's description: the texts it is made of, read straight from flash,
+// and where each of its lines starts. Lines are laid out in pixels as each
+// text is appended, from the word widths the reader gives, the same greedy way
+// as ever: spaces are dropped at the start of a line, and a word too wide for
+// a whole line ends the layout. So do more than DESCRIPTION_MAX_TEXTS texts or
+// DESCRIPTION_MAX_LINES lines; the solver reports any description cut short
+// this way, as the game shows no sign of it.
+class description_type {
+public:
+	description_type()
+	: text_count( 0 )
+	, line_count( 0 )
+	, cur_line_width( 0 )
+	, line_width( 0 )
+	, line_open( false )
+	, layout_stopped( false )
+	{ }
+
+	void clear(uint8_t new_line_width){
+		text_count = 0;
+		line_count = 0;
+		cur_line_width = 0;
+		line_width = new_line_width;
+		line_open = false;
+		layout_stopped = false;
+	}
+
+	void append(text_id text){
+		if (text_count == DESCRIPTION_MAX_TEXTS){
+			layout_stopped = true;
+			return;
+		}
+
+		description_position_type word_start = { text_count, text };
+		text_reader_type reader(text);
+		texts[text_count++] = text;
+
+		while (reader.next_word()){
+			description_position_type word_end = { word_start.text_index, reader.get_position() };
+			if (reader.follows_space())
+				add_space();
+			add_word(reader.get_word_width(), word_start, word_end);
+			word_start = word_end;
+		}
+	}
+
+	uint8_t get_text_count(){
+		return text_count;
+	}
+
+	text_id get_text(uint8_t text_index){
+		return texts[text_index];
+	}
+
+	uint8_t get_line_count(){
+		return line_count;
+	}
+
+	// Whether any of the texts appended is missing from the lines.
+	bool is_cut_short(){
+		return layout_stopped;
+	}
+
+	// Draws a line without its trailing spaces.
+	void draw_line(uint8_t line){
+		description_position_type cur_position = line_starts[line];
+		description_position_type end_of_line = line_starts[line + 1];
+		text_reader_type reader(cur_position.code);
+		uint8_t pending_spaces = 0;
+		bool word_printed = false;
+
+		while (cur_position.text_index != end_of_line.text_index || cur_position.code != end_of_line.code){
+			if (!reader.next_word()){
+				cur_position.text_index++;
+				cur_position.code = texts[cur_position.text_index];
+				reader = text_reader_type(cur_position.code);
+				continue;
+			}
+			cur_position.code = reader.get_position();
+
+			if (reader.follows_space() && word_printed)
+				pending_spaces++;
+			if (reader.get_word_length() > 0){
+				for (; pending_spaces > 0; pending_spaces--)
+					draw_char(' ');
+				reader.draw_word();
+				word_printed = true;
+			}
+		}
+	}
+
+private:
+	text_id texts[DESCRIPTION_MAX_TEXTS];
+	// Start of each line, followed by the end of the last line.
+	description_position_type line_starts[DESCRIPTION_MAX_LINES + 1];
+	uint8_t text_count;
+	uint8_t line_count;
+	uint8_t cur_line_width;
+	uint8_t line_width;
+	bool line_open;
+	bool layout_stopped;
+
+	void add_space(){
+		if (line_open){
+			uint8_t space_width = char_width(' ');
+			if (cur_line_width + space_width <= line_width)
+				cur_line_width += space_width;
+			else
+				line_open = false;
+		}
+	}
+
+	void add_word(uint16_t word_width, description_position_type word_start, description_position_type word_end){
+		if (word_width == 0 || layout_stopped)
+			return;
+
+		if (line_open && cur_line_width + word_width <= line_width)
+			cur_line_width += word_width;
+		else if (word_width <= line_width && line_count < DESCRIPTION_MAX_LINES){
+			line_starts[line_count++] = word_start;
+			cur_line_width = word_width;
+			line_open = true;
+		}
+		else {
+			layout_stopped = true;
+			return;
+		}
+		line_starts[line_count] = word_end;
+	}
+};
+
+// The bits of a bit_set_type are kept in words as wide as the target counts
+// at once: bytes looked up in a table on the AVR, which has no popcount, and
+// 64-bit words counted by the compiler's popcount on the host.
+#ifdef __AVR__
+
+typedef uint8_t bit_set_word;
+
+#define BIT_COUNTS_2(n) n, n + 1, n + 1, n + 2
+#define BIT_COUNTS_4(n) BIT_COUNTS_2(n), BIT_COUNTS_2(n + 1), BIT_COUNTS_2(n + 1), BIT_COUNTS_2(n + 2)
+#define BIT_COUNTS_6(n) BIT_COUNTS_4(n), BIT_COUNTS_4(n + 1), BIT_COUNTS_4(n + 1), BIT_COUNTS_4(n + 2)
+
+// The number of bits set in each byte value.
+const uint8_t bit_counts[256] PROGMEM = { BIT_COUNTS_6(0), BIT_COUNTS_6(1), BIT_COUNTS_6(1), BIT_COUNTS_6(2) };
+
+uint8_t count_bits(bit_set_word value){
+	return pgm_read_byte(&bit_counts[value]);
+}
+
+// The number of the lowest set bit; value must not be 0.
+uint8_t lowest_set_bit(bit_set_word value){
+	uint8_t bit = 0;
+	for (; !(value & 1); value >>= 1)
+		bit++;
+	return bit;
+}
+
+#else
+
+typedef uint64_t bit_set_word;
+
+uint8_t count_bits(bit_set_word value){
+	return __builtin_popcountll(value);
+}
+
+uint8_t lowest_set_bit(bit_set_word value){
+	return __builtin_ctzll(value);
+}
+
+#endif
+
+#define BIT_SET_WORD_BITS (8 * sizeof(bit_set_word))
+
+// A fixed number of bits, numbered from 0, that also answers which set bit
+// comes n-th (select) and how many set bits come before a given one (rank).
+// It keeps, for each word, the number of bits set in the words before it, so
+// rank is one lookup and one count, and select a binary search of those
+// counts. set() and clear() pay for this by updating the counts after the
+// word they change.
+template <uint16_t bit_count>
+class bit_set_type {
+public:
+	bit_set_type(){
+		clear_all();
+	}
+
+	void clear_all(){
+		memset(words, 0, sizeof(words));
+		memset(ranks, 0, sizeof(ranks));
+	}
+
+	void set(uint16_t bit){
+		if (!test(bit)){
+			words[bit / BIT_SET_WORD_BITS] |= get_mask(bit);
+			for (uint8_t word_index = bit / BIT_SET_WORD_BITS + 1; word_index <= word_count; word_index++)
+				ranks[word_index]++;
+		}
+	}
+
+	void clear(uint16_t bit){
+		if (test(bit)){
+			words[bit / BIT_SET_WORD_BITS] &= ~get_mask(bit);
+			for (uint8_t word_index = bit / BIT_SET_WORD_BITS + 1; word_index <= word_count; word_index++)
+				ranks[word_index]--;
+		}
+	}
+
+	boolean test(uint16_t bit){
+		return (words[bit / BIT_SET_WORD_BITS] & get_mask(bit)) != 0;
+	}
+
+	uint16_t count(){
+		return ranks[word_count];
+	}
+
+	// The number of set bits before bit.
+	uint16_t rank(uint16_t bit){
+		uint8_t word_index = bit / BIT_SET_WORD_BITS;
+		uint16_t set_bits = ranks[word_index];
+		if (bit % BIT_SET_WORD_BITS)
+			set_bits += count_bits(words[word_index] & (get_mask(bit) - 1));
+		return set_bits;
+	}
+
+	// The set bit with set_bit_rank set bits before it, or bit_count if there
+	// are not that many.
+	uint16_t select(uint16_t set_bit_rank){
+		if (set_bit_rank >= count())
+			return bit_count;
+
+		// The last word with no more than set_bit_rank bits set before it.
+		uint8_t low = 0;
+		uint8_t high = word_count - 1;
+		while (low < high){
+			uint8_t middle = (low + high + 1) / 2;
+			if (ranks[middle] <= set_bit_rank)
+				low = middle;
+			else
+				high = middle - 1;
+		}
+
+		bit_set_word value = words[low];
+		for (set_bit_rank -= ranks[low]; set_bit_rank > 0; set_bit_rank--)
+			value &= value - 1;
+		return low * BIT_SET_WORD_BITS + lowest_set_bit(value);
+	}
+
+private:
+	static const uint8_t word_count = (bit_count + BIT_SET_WORD_BITS - 1) / BIT_SET_WORD_BITS;
+
+	static bit_set_word get_mask(uint16_t bit){
+		return (bit_set_word)1 << (bit % BIT_SET_WORD_BITS);
+	}
+
+	bit_set_word words[word_count];
+	// ranks[n] is the number of bits set in the words before words[n], and
+	// ranks[word_count] the number set in all of them.
+	uint8_t ranks[word_count + 1];
+
+	static_assert(bit_count > 0 && bit_count <= 255, "bit_set_type counts its bits in a uint8_t");
+};
+
+// Items are numbered, and the player's inventory is a bit for each.
+typedef uint8_t player_item_id;
+
+#define PLAYER_ITEM_ID_MASTER_KEY		0
+#define PLAYER_ITEM_ID_OIL_LAMP			1
+#define PLAYER_ITEM_ID_SWORD			2
+#define PLAYER_ITEM_ID_BROKEN_KEY		3
+#define PLAYER_ITEM_ID_BLANK_KEY		4
+#define PLAYER_ITEM_ID_MOD_CHEST_KEY	5
+#define PLAYER_ITEM_ID_SHEET			6
+#define PLAYER_ITEM_ID_COPIED_KEY		7
+#define PLAYER_ITEM_ID_CHEST_KEY		8
+#define PLAYER_ITEM_ID_ROPE				9
+#define PLAYER_ITEM_COUNT				10
+
+#define PLAYER_ITEM_ID_NONE 			(0xff)
+
+static_assert(PLAYER_ITEM_COUNT <= PLAYER_ITEM_ID_NONE, "player_item_id must hold every item");
+
+// Indexed by player_item_id.
+const text_id player_item_name_full_list[PLAYER_ITEM_COUNT] PROGMEM =
+	{ TEXT_ITEM_MASTER_KEY
+	, TEXT_ITEM_LAMP
+	, TEXT_ITEM_BROAD_SWORD
+	, TEXT_ITEM_BROKEN_KEY
+	, TEXT_ITEM_BLANK_KEY
+	, TEXT_ITEM_MODIFIED_CHEST_KEY
+	, TEXT_ITEM_SHEET
+	, TEXT_ITEM_COPIED_KEY
+	, TEXT_ITEM_CHEST_KEY
+	, TEXT_ITEM_ROPE
 	};
 
 class player_type
 {
 public:
 	player_type()
-	: items_carried( 0 )
-	, achievements( 0 )
+	: achievements( 0 )
 	{ }
 
 	void add_achievement(event_tag_id new_achievement){
@@ -131,86 +848,58 @@ public:
 	}
 
 	void add_item(player_item_id item){
-		items_carried |= item;
+		items_carried.set(item);
 	}
 
 	void remove_item(player_item_id item){
-		items_carried &= ~item;
+		items_carried.clear(item);
+	}
+
+	void remove_all_items(){
+		items_carried.clear_all();
 	}
 
 	boolean has_item(player_item_id item){
-		return (items_carried & item) == item;
+		return items_carried.test(item);
 	}
 
+	event_tag_id get_achievements(){
+		return achievements;
+	}
+
+	bit_set_type<PLAYER_ITEM_COUNT>& get_items(){
+		return items_carried;
+	}
+
+	// The item_index-th item carried, in item order, as the item menu lists
+	// them, or PLAYER_ITEM_ID_NONE.
 	player_item_id get_item_by_index(uint8_t item_index){
-		player_item_id result = 0;
-		uint8_t count = 0;
-
-		for (player_item_id id = 1; id < PLAYER_ITEM_ID_ALL; id <<= 1){
-			if (has_item(id)){
-				if (count == item_index){
-					result = id;
-					break;
-				}
-				count++;
-			}
-		}
-		return result;
+		uint16_t item = items_carried.select(item_index);
+		return item < PLAYER_ITEM_COUNT ? item : PLAYER_ITEM_ID_NONE;
 	}
 
-	uint8_t load_item_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const char* available_item_list[MAX_OBJECTS_ON_PLAYER];
-		char *cur_buf_pos = menu_buffer;
-		uint8_t count = 0;
+	uint8_t load_item_menu(text_id *menu_texts, uint8_t menu_length){
+		uint8_t count = items_carried.count();
+		if (count > menu_length)
+			count = menu_length;
 
-		for (uint8_t i = 0; i < MAX_OBJECTS_ON_PLAYER; i++){
-			if ( has_item( 1 << ((uint16_t)i) ) ){
-				count++;
-				if (count > menu_length)
-					break;
-				strncpy_P(cur_buf_pos, (char*)pgm_read_word(&(player_item_name_full_list[i])), menu_item_length);
-				cur_buf_pos[menu_item_length-1] = '\0';
-				cur_buf_pos += menu_item_length;
-			}
-		}
+		for (uint8_t i = 0; i < count; i++)
+			menu_texts[i] = pgm_read_word(&player_item_name_full_list[items_carried.select(i)]);
 		return count;
 	}
 
 private:
-	player_item_id items_carried;
+	bit_set_type<PLAYER_ITEM_COUNT> items_carried;
 	event_tag_id achievements;
 } player;
 
-void load_progmem_string_to_var (const char* progmem_string, char *output_string, uint8_t limit) {
-	strncpy_P(output_string, progmem_string, limit);
-	output_string[limit-1] = '\0';
-}
-
-void copy_string_array_from_src_to_buf(const char** src, uint8_t array_length, char* buf, uint8_t buf_size, uint8_t str_len){
-	char *cur_buf_pos = buf;
-	char *end_of_buf = buf + buf_size*str_len;
-	uint8_t cur_str_len = str_len;
-
-	for (uint8_t i=0; i<array_length; i++){
-		if (cur_buf_pos + strlen_P(src[i]) >= end_of_buf)
-			cur_str_len = end_of_buf - cur_buf_pos;
-		load_progmem_string_to_var(src[i], cur_buf_pos, cur_str_len);
-		cur_buf_pos += str_len;
-		if (cur_buf_pos >= end_of_buf)
-			break;
-	}
-}
-
-void copy_string_array_from_src_to_buf(const __FlashStringHelper** src, uint8_t array_length, char* buf, uint8_t buf_size, uint8_t str_len){
-	copy_string_array_from_src_to_buf((const char **)src, array_length, buf, buf_size, str_len);
-}
+typedef uint8_t room_flag_id;
 
-void append_progmem_string_to_string(const __FlashStringHelper* src, char *dest, uint8_t max_string_length){
-	uint16_t used_length = strlen(dest);
-	uint16_t remaining_length = max_string_length - used_length;
+// What the rooms remember between visits: one bit for each flag listed in
+// DarkTowerRooms.txt.
+typedef bit_set_type<ROOM_FLAG_COUNT> room_state_type;
 
-	strncat_P(dest, (const char*)src, remaining_length);
-}
+room_state_type room_state;
 
 // ------------------------------------------------
 // Game Events
@@ -218,92 +907,222 @@ void append_progmem_string_to_string(const __FlashStringHelper* src, char *dest,
 
 class event;
 
-typedef void (event::*load_description_type)(char *string_to_init, uint8_t max_string_length);
-typedef void (event::*load_object_menu_type)(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length);
-typedef event (event::*process_action_on_object_type)(uint8_t selected_action, uint8_t object_selected);
-typedef event (event::*process_item_on_object_type)(player_item_id selected_item, uint8_t object_selected);
-typedef event (event::*get_prelude_event_type)();
-typedef bool (event::*simple_bool_question_type)();
+typedef void (event::*load_description_type)(description_type& description_to_init);
+typedef uint8_t (event::*load_object_menu_type)(text_id *menu_texts, uint8_t menu_length);
+typedef void (event::*process_action_on_object_type)(uint8_t selected_action, uint8_t object_selected, event& next_event);
+typedef void (event::*process_item_on_object_type)(player_item_id selected_item, uint8_t object_selected, event& next_event);
+typedef void (event::*get_prelude_event_type)(event& next_event);
+
+// The handlers an event type runs, kept in flash in event::behaviours.
+struct event_behaviour_type
+{
+	load_description_type load_description;
+	load_object_menu_type load_object_menu;
+	process_action_on_object_type process_action_on_object;
+	process_item_on_object_type process_item_on_object;
+	get_prelude_event_type get_continue_event;
+};
+
+template <typename handler_type>
+handler_type read_progmem_handler(const handler_type& progmem_handler){
+	handler_type handler;
+	memcpy_P(&handler, &progmem_handler, sizeof(handler));
+	return handler;
+}
+
+#define CALL_BEHAVIOUR(the_event, the_handler) (the_event.*read_progmem_handler(event::behaviours[the_event.type].the_handler))
+
+#define EVENT_HANDLE_DATA_BITS 13
+#define EVENT_HANDLE_TYPE_BITS 5
+#define EVENT_HANDLE_SCROLL_BITS 6
+#define EVENT_HANDLE_SCROLL_MAX ((1 << EVENT_HANDLE_SCROLL_BITS) - 1)
+
+static_assert(EVENT_HANDLE_DATA_BITS + EVENT_HANDLE_TYPE_BITS + EVENT_HANDLE_SCROLL_BITS == 24, "an event handle is three bytes");
+static_assert(EVENT_TYPE_ID_COUNT <= (1 << EVENT_HANDLE_TYPE_BITS), "EVENT_HANDLE_TYPE_BITS must hold every event type");
+static_assert(sizeof(text_streams) <= (1 << EVENT_HANDLE_DATA_BITS), "EVENT_HANDLE_DATA_BITS must hold every text_id");
+
+// An event left behind in the presenter's history, packed into three bytes:
+// its type, its description or, for a room, its local event tags, and how far
+// the screen was scrolled. The rest of an event follows from its type.
+class event_handle_type {
+public:
+	event_handle_type() { }
+
+	event_handle_type(event_type_id type, uint16_t data, uint8_t scroll_position){
+		if (scroll_position > EVENT_HANDLE_SCROLL_MAX)
+			scroll_position = EVENT_HANDLE_SCROLL_MAX;
+
+		uint32_t packed = data
+			| ((uint32_t)type << EVENT_HANDLE_DATA_BITS)
+			| ((uint32_t)scroll_position << (EVENT_HANDLE_DATA_BITS + EVENT_HANDLE_TYPE_BITS));
+		bytes[0] = packed;
+		bytes[1] = packed >> 8;
+		bytes[2] = packed >> 16;
+	}
+
+	event_type_id get_type(){
+		return (get_packed() >> EVENT_HANDLE_DATA_BITS) & ((1 << EVENT_HANDLE_TYPE_BITS) - 1);
+	}
+
+	uint16_t get_data(){
+		return get_packed() & ((1 << EVENT_HANDLE_DATA_BITS) - 1);
+	}
+
+	uint8_t get_scroll_position(){
+		return get_packed() >> (EVENT_HANDLE_DATA_BITS + EVENT_HANDLE_TYPE_BITS);
+	}
+
+private:
+	uint8_t bytes[3];
+
+	uint32_t get_packed(){
+		return bytes[0] | ((uint16_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16);
+	}
+};
 
 // Do not use virtual methods because the vtable resides in both progmem, and sram.
 // Do not add properties to sub-classes otherwise object shearing will result.
+// A sub-class sets its type, and its handlers are listed for that type in
+// event::behaviours, so an event is only a few bytes to copy.
 class event
 {
 public:
 	event()
-	: internal_load_description( &default_load_description )
-	, internal_load_object_menu( &default_load_object_menu )
-	, internal_process_action_on_object( &default_process_action_on_object )
-	, internal_process_item_on_object( &default_process_item_on_object )
-	, internal_get_continue_event( &default_get_continue_event )
-	, internal_actions_are_allowed( &default_actions_are_allowed )
-	, internal_return_to_previous_event( &default_should_return_to_previous_event )
-	, description( (const char*)F("Nothing happens.") )
+	: type( EVENT_TYPE_ID_NOTHING )
+	, description( TEXT_NOTHING_HAPPENS )
 	, allow_actions( false )
 	, return_to_previous_event( true )
 	, local_event_tags( 0 )
 	{ }
 
-	event(const __FlashStringHelper* progmem_description)
+	event(text_id new_description)
+	: event()
+	{
+		description = new_description;
+	}
+
+	// Rebuilds the event a handle was taken from, without running the
+	// constructor of its type again. Only plain events lead back to the event
+	// before them; the story's own events always move the story on.
+	event(event_handle_type handle)
 	: event()
 	{
-		description = (const char*)progmem_description;
+		type = handle.get_type();
+		if (get_room() == ROOM_ID_NONE){
+			description = handle.get_data();
+			return_to_previous_event = (type == EVENT_TYPE_ID_NOTHING);
+		}
+		else {
+			description = pgm_read_word(&rooms[get_room()].description);
+			allow_actions = true;
+			local_event_tags = handle.get_data();
+		}
+	}
+
+	event_handle_type get_handle(uint8_t scroll_position){
+		if (get_room() == ROOM_ID_NONE)
+			return event_handle_type(type, description, scroll_position);
+		return event_handle_type(type, local_event_tags, scroll_position);
 	}
 
-	void load_description(char *string_to_init, uint8_t max_string_length){
-		CALL_REF((*this),internal_load_description)(string_to_init, max_string_length);
+	void load_description(description_type& description_to_init){
+		CALL_BEHAVIOUR((*this),load_description)(description_to_init);
 	}
 
-	void load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		CALL_REF((*this),internal_load_object_menu)(menu_buffer, menu_length, menu_item_length);
+	// Fills menu_texts with the names of the objects on offer, and returns how
+	// many there are.
+	uint8_t load_object_menu(text_id *menu_texts, uint8_t menu_length){
+		return CALL_BEHAVIOUR((*this),load_object_menu)(menu_texts, menu_length);
 	}
 
-	event process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		return CALL_REF((*this),internal_process_action_on_object)(selected_action, object_selected);
+	// The handlers below build the event that follows this one in next_event,
+	// which must not be this event.
+	void process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
+		PROFILE_SCOPE(PROFILE_SECTION_PROCESS_ACTION);
+		CALL_BEHAVIOUR((*this),process_action_on_object)(selected_action, object_selected, next_event);
 	}
 
-	event process_item_on_object(player_item_id selected_item, uint8_t object_selected){
-		return CALL_REF((*this),internal_process_item_on_object)(selected_item, object_selected);
+	void process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event){
+		PROFILE_SCOPE(PROFILE_SECTION_PROCESS_ITEM);
+		CALL_BEHAVIOUR((*this),process_item_on_object)(selected_item, object_selected, next_event);
 	}
 
-	event get_continue_event(){
-		return CALL_REF((*this),internal_get_continue_event)();
+	void get_continue_event(event& next_event){
+		CALL_BEHAVIOUR((*this),get_continue_event)(next_event);
+	}
+
+	// Events are only ever built in place, in slots the presenter owns, by
+	// build_event(), which checks at compile time that they fit.
+	void* operator new(size_t, event* slot){
+		return slot;
 	}
 
 	bool actions_are_allowed(){
-		return CALL_REF((*this),internal_actions_are_allowed)();
+		return allow_actions;
 	}
 
 	bool should_return_to_previous_event(){
-		return CALL_REF((*this),internal_return_to_previous_event)();
+		return return_to_previous_event;
+	}
+
+	event_type_id get_type(){
+		return type;
 	}
 
+	// ROOM_ID_NONE unless this event is one of the rooms.
+	room_id get_room(){
+		if (type < EVENT_TYPE_ID_FIRST_ROOM)
+			return ROOM_ID_NONE;
+		return type - EVENT_TYPE_ID_FIRST_ROOM;
+	}
+
+	uint8_t get_local_event_tags(){
+		return local_event_tags;
+	}
+
+	// Indexed by event_type_id.
+	static const event_behaviour_type behaviours[];
+
 protected:
-	const char *description;
+	event_type_id type;
+	text_id description;
 	bool allow_actions;
 	bool return_to_previous_event;
 	uint8_t local_event_tags;
 
-	load_description_type internal_load_description;
-	load_object_menu_type internal_load_object_menu;
-	process_action_on_object_type internal_process_action_on_object;
-	process_item_on_object_type internal_process_item_on_object;
-	get_prelude_event_type internal_get_continue_event;
-	simple_bool_question_type internal_actions_are_allowed;
-	simple_bool_question_type internal_return_to_previous_event;
-
-	void default_load_description(char *string_to_init, uint8_t max_string_length);
-	void default_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length) {};
-	event default_process_action_on_object(uint8_t selected_action, uint8_t object_selected){ return event(); }
-	event default_process_item_on_object(player_item_id selected_item, uint8_t object_selected){ return event(); }
-	event default_get_continue_event() { return event(); }
-	bool default_actions_are_allowed() { return allow_actions; }
-	bool default_should_return_to_previous_event() { return return_to_previous_event; }
+	void default_load_description(description_type& description_to_init);
+	uint8_t default_load_object_menu(text_id *, uint8_t) { return 0; };
+	void default_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event);
+	void default_process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event);
+	void default_get_continue_event(event& next_event);
 };
 
-void event::default_load_description(char *string_to_init, uint8_t max_string_length)
+void event::default_load_description(description_type& description_to_init)
+{
+	description_to_init.append(description);
+}
+
+// Builds an event of the given class straight into slot. Sub-classes add no
+// members, so any of them fits in an event's space.
+template <typename event_class, typename... argument_types>
+void build_event(event& slot, argument_types... arguments){
+	static_assert(sizeof(event_class) == sizeof(event), "event sub-classes must not add members");
+	new (&slot) event_class(arguments...);
+}
+
+void event::default_process_action_on_object(uint8_t, uint8_t, event& next_event)
+{
+	build_event<event>(next_event);
+}
+
+void event::default_process_item_on_object(player_item_id, uint8_t, event& next_event)
+{
+	build_event<event>(next_event);
+}
+
+void event::default_get_continue_event(event& next_event)
 {
-	load_progmem_string_to_var(description, string_to_init, max_string_length);
+	build_event<event>(next_event);
 }
 
 struct
@@ -311,130 +1130,243 @@ struct
 	game_state_id state = GAME_STATE_ID_TITLE;
 } game_state;
 
-const char drink_pink_vial[] PROGMEM = "You take the pink vial and drink it. It tastes foul. A few moments later, you start coughing blood violently and collapse. Everything goes dark.";
-const char open_chest_description[] PROGMEM = "The key slots in and turns. The chest unlocks and you open it. The door slams shut behind you. Inside you see ";
-const char f0_hall_description[] PROGMEM = "The light from your lamp shows this is a store room with many barrels. There is a well in the middle of the room.";
+// A room from DarkTowerRooms.h. Its description, its objects and the plain
+// answers to looking at, using and taking them come from the room tables; a
+// room's own class only adds what changes as the story goes on.
+class room_event : public event {
+	friend class event;
+
+public:
+	room_event(room_id room){
+		description = pgm_read_word(&rooms[room].description);
+		allow_actions = true;
+		type = EVENT_TYPE_ID_FIRST_ROOM + room;
+	}
+
+	// Back in a room as it was saved.
+	room_event(room_id room, uint8_t saved_event_tags)
+	: room_event(room)
+	{
+		local_event_tags = saved_event_tags;
+	}
+
+protected:
+	uint8_t get_object_count(){
+		return pgm_read_byte(&rooms[get_room()].object_count);
+	}
+
+	const room_object_type* get_object(uint8_t object_index){
+		return &room_objects[pgm_read_word(&rooms[get_room()].first_object) + object_index];
+	}
+
+	text_id get_look_description(uint8_t object_index){
+		return pgm_read_word(&get_object(object_index)->look);
+	}
+
+	// Loads the names of the room's first object_count objects.
+	uint8_t load_room_object_menu(text_id *menu_texts, uint8_t menu_length, uint8_t object_count){
+		if (object_count > menu_length)
+			object_count = menu_length;
+
+		for (uint8_t i = 0; i < object_count; i++)
+			menu_texts[i] = pgm_read_word(&get_object(i)->name);
+		return object_count;
+	}
+
+	void real_load_description(description_type& description_to_init){
+		default_load_description(description_to_init);
+	}
+
+	uint8_t real_load_object_menu(text_id *menu_texts, uint8_t menu_length){
+		return load_room_object_menu(menu_texts, menu_length, get_object_count());
+	}
+
+	void real_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
+		const room_object_type* room_object = get_object(object_selected);
+		text_id answer = TEXT_NONE;
+
+		switch (selected_action){
+		case ACTION_ID_LOOK:
+			answer = pgm_read_word(&room_object->look);
+			break;
+		case ACTION_ID_USE:
+			{
+				room_id exit = pgm_read_byte(&room_object->exit);
+				if (exit != ROOM_ID_NONE)
+					return build_event<room_event>(next_event, exit);
+			}
+			answer = pgm_read_word(&room_object->use);
+			break;
+		case ACTION_ID_TAKE:
+			answer = pgm_read_word(&room_object->take);
+			break;
+		}
+
+		if (answer == TEXT_NONE)
+			return build_event<event>(next_event);
+		return build_event<event>(next_event, answer);
+	}
 
-event create_f0_main_hall_event();
-event create_f1_main_hall_event();
-event create_f2_main_hall_event();
-event create_f3_main_hall_event();
+	void real_process_item_on_object(player_item_id, uint8_t, event& next_event){
+		return build_event<event>(next_event);
+	}
+};
 
 class intro_event : public event {
+	friend class event;
+
 public:
 	intro_event(){
-		description = (const char*)F("Stairs lead up to the first floor of the abandoned tower. A tower flowing with what Angels fear; the dark. You ascend hoping to find a way to break the curse of undeath that has come upon you. The tower's doors close behind you. You are trapped!");
-		internal_get_continue_event = static_cast<get_prelude_event_type>(&real_get_continue_event);
+		description = TEXT_INTRO_DESCRIPTION;
+		type = EVENT_TYPE_ID_INTRO;
 		return_to_previous_event = false;
 		player.remove_achievement(EVENT_TAG_ID_ALL);
-		player.remove_item(PLAYER_ITEM_ID_ALL);
+		player.remove_all_items();
+		room_state.clear_all();
 
 		// temp for testing - 6 bytes needed
 		//player.add_item(PLAYER_ITEM_ID_SHEET);
 	}
 
 private:
-	event real_get_continue_event(){
-		return create_f1_main_hall_event();
+	void real_get_continue_event(event& next_event){
+		return build_event<room_event>(next_event, ROOM_ID_F1_MAIN_HALL);
 	}
 };
 
 class resurrect_event : public event {
+	friend class event;
+
 public:
 	resurrect_event(){
-		description = (const char*)F("You wake up in the entrance hall of the tower. Not sure of what has happened, you find you have lost your items!");
-		internal_get_continue_event = static_cast<get_prelude_event_type>(&real_get_continue_event);
+		description = TEXT_RESURRECT_DESCRIPTION;
+		type = EVENT_TYPE_ID_RESURRECT;
 		return_to_previous_event = false;
 		player.remove_achievement(EVENT_TAG_ID_ALL);
-		player.remove_item(PLAYER_ITEM_ID_ALL);
+		player.remove_all_items();
+		room_state.clear_all();
 	}
 
 private:
-	event real_get_continue_event(){
-		return create_f1_main_hall_event();
+	void real_get_continue_event(event& next_event){
+		return build_event<room_event>(next_event, ROOM_ID_F1_MAIN_HALL);
 	}
 };
 
 class return_to_game : public event {
+	friend class event;
+
 public:
 	return_to_game(){
-		description = (const char *)F("Well Done! You have won! If you would like to play again, then please continue.");
-		internal_get_continue_event = static_cast<get_prelude_event_type>(&real_get_continue_event);
+		description = TEXT_WON_DESCRIPTION;
+		type = EVENT_TYPE_ID_RETURN_TO_GAME;
 		return_to_previous_event = false;
 	}
 
 protected:
-	event real_get_continue_event(){
-		return intro_event();
+	void real_get_continue_event(event& next_event){
+		return build_event<intro_event>(next_event);
 	}
 };
 
 class win_event : public event {
+	friend class event;
+
 public:
 	win_event(){
-		description = (const char *)F("You leave the tower feeling reborn. The ordeal of the tower may well live with you forever, but now no longer bearing the curse of undeath you can explore and enjoy everything the world has to offer.");
-		internal_get_continue_event = static_cast<get_prelude_event_type>(&real_get_continue_event);
+		description = TEXT_WIN_DESCRIPTION;
+		type = EVENT_TYPE_ID_WIN;
 		return_to_previous_event = false;
 	}
 
 protected:
-	event real_get_continue_event(){
-		return return_to_game();
+	void real_get_continue_event(event& next_event){
+		return build_event<return_to_game>(next_event);
 	}
 };
 
 class player_dies_event : public event {
+	friend class event;
+
 public:
 	player_dies_event(){
-		description = (const char *)F("");
-		internal_get_continue_event = static_cast<get_prelude_event_type>(&real_get_continue_event);
+		description = TEXT_EMPTY;
+		type = EVENT_TYPE_ID_PLAYER_DIES;
 		return_to_previous_event = false;
 	}
 
-	player_dies_event(const __FlashStringHelper* progmem_description)
+	player_dies_event(text_id new_description)
 	: player_dies_event()
 	{
-		description = (const char*)progmem_description;
+		description = new_description;
 	}
 
 protected:
-	event real_get_continue_event(){
-		return resurrect_event();
+	void real_get_continue_event(event& next_event){
+		return build_event<resurrect_event>(next_event);
 	}
 };
 
 struct drinks_yellow_vial_event : public event
 {
+	friend class event;
+
 	drinks_yellow_vial_event(){
-		description = (const char *)F("You take the yellow vial and drink it. It tastes foul. A few moments later, you feel warmth return to your body. You starting breathing again. The potion has cured you of the curse of undeath!");
-		internal_get_continue_event = static_cast<get_prelude_event_type>(&real_get_continue_event);
+		description = TEXT_DRINK_YELLOW_VIAL;
+		type = EVENT_TYPE_ID_DRINKS_YELLOW_VIAL;
 		return_to_previous_event = false;
 	}
 
 protected:
-	event real_get_continue_event(){
-		return win_event();
+	void real_get_continue_event(event& next_event){
+		return build_event<win_event>(next_event);
 	}
 };
 
-class f0_in_the_well_event : public event {
+class f0_monster_dies_event : public event {
+	friend class event;
+
 public:
-	f0_in_the_well_event(){
-		description = (const char *)F("The water comes up to your waist, it feels cold.");
-		allow_actions = true;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_load_description = static_cast<load_description_type>(&real_load_description);
+	f0_monster_dies_event(){
+		description = TEXT_F0_BAT_DIES;
+		type = EVENT_TYPE_ID_F0_MONSTER_DIES;
+		return_to_previous_event = false;
 	}
 
 private:
-	static const uint8_t EVENT_NOTICE_KEY = (1<<0);
+	void real_get_continue_event(event& next_event){
+		return build_event<room_event>(next_event, ROOM_ID_F0_LIGHT_ROOM);
+	}
+};
+
+class f4_door_unlocked_event : public event {
+	friend class event;
 
-	void real_load_description(char *string_to_init, uint8_t max_string_length)
+public:
+	f4_door_unlocked_event(){
+		description = TEXT_F4_DOOR_UNLOCKED;
+		type = EVENT_TYPE_ID_F4_DOOR_UNLOCKED;
+		return_to_previous_event = false;
+	}
+
+private:
+	void real_get_continue_event(event& next_event){
+		return build_event<room_event>(next_event, ROOM_ID_F4_MAIN_HALL);
+	}
+};
+
+// The rooms' own handlers. These classes are never built; a room is always a
+// room_event, and its type picks out the handlers below.
+
+class f0_in_the_well_event : public room_event {
+	friend class event;
+
+private:
+	void real_load_description(description_type& description_to_init)
 	{
-		default_load_description(string_to_init, max_string_length);
+		default_load_description(description_to_init);
 		if (should_show_crystal())
-			append_progmem_string_to_string(F(" You can see what looks like a crystal in the water."), string_to_init, max_string_length);
+			description_to_init.append(TEXT_F0_WELL_CRYSTAL_VISIBLE);
 	}
 
 	bool should_show_crystal(){
@@ -445,7 +1377,7 @@ private:
 	}
 
 	bool should_show_key(){
-		bool key_has_been_noticed = local_event_tags & EVENT_NOTICE_KEY;
+		bool key_has_been_noticed = room_state.test(ROOM_FLAG_F0_IN_THE_WELL_NOTICE_KEY);
 		bool key_is_available = !player.has_item(PLAYER_ITEM_ID_BLANK_KEY);
 		bool key_is_not_cut = !player.has_item(PLAYER_ITEM_ID_COPIED_KEY);
 		bool crystal_is_shown = should_show_crystal();
@@ -453,14 +1385,9 @@ private:
 		return (key_has_been_noticed && key_is_available && crystal_is_shown && key_is_not_cut);
 	}
 
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Water")
-			, F("Rope")
-			, F("Crystal")
-			, F("Key")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
+	// The crystal and the key are the last two objects.
+	uint8_t real_load_object_menu(text_id *menu_texts, uint8_t menu_length){
+		uint8_t object_list_length = get_object_count();
 		object_list_length -= 2;
 
 		if (should_show_crystal()){
@@ -469,63 +1396,42 @@ private:
 				object_list_length++;
 		}
 
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
+		return load_room_object_menu(menu_texts, menu_length, object_list_length);
 	}
 
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The water is clear and stagnant.")
-			, F("The rope hangs down from above.")
-			, F("The diamond-shaped crystal seems to glow with magical energy.")
-			, F("The key is has a no cuttings on its head. It is like a blank key.")
-			, F("You notice in the light of the crystal there is a key in water.")
-			};
-
+	void real_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
 		switch (selected_action){
 		case ACTION_ID_LOOK:
 			if (object_selected == 0 && should_show_crystal()){
-				local_event_tags |= EVENT_NOTICE_KEY;
-				object_selected = 4;
+				room_state.set(ROOM_FLAG_F0_IN_THE_WELL_NOTICE_KEY);
+				return build_event<event>(next_event, TEXT_F0_WELL_NOTICE_KEY);
 			}
-			return event(look_descriptions[object_selected]);
-		case ACTION_ID_USE:
-			if (object_selected == 1)
-				return create_f0_main_hall_event();
 			break;
 		case ACTION_ID_TAKE:
 			if (object_selected == 2){
 				bool key_disapears = should_show_key();
 				player.add_item(PLAYER_ITEM_ID_MASTER_KEY);
 				if ( key_disapears )
-					return event(F("You take the diamond-shaped crystal. The key in the water fades into nothingness."));
+					return build_event<event>(next_event, TEXT_F0_WELL_TAKE_CRYSTAL_KEY_FADES);
 				else
-					return event(F("You take the diamond-shaped crystal."));
+					return build_event<event>(next_event, TEXT_F0_WELL_TAKE_CRYSTAL);
 			}
 			if (object_selected == 3){
 				player.add_item(PLAYER_ITEM_ID_BLANK_KEY);
-				return event(F("You take the blank key."));
+				return build_event<event>(next_event, TEXT_F0_WELL_TAKE_KEY);
 			}
 			break;
 		}
-		return event();
+		return room_event::real_process_action_on_object(selected_action, object_selected, next_event);
 	}
 };
 
-class f0_light_room_event : public event {
-public:
-	f0_light_room_event(){
-		description = f0_hall_description;
-		allow_actions = true;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_process_item_on_object = static_cast<process_item_on_object_type>(&real_process_item_on_object);
-	}
+class f0_light_room_event : public room_event {
+	friend class event;
 
 private:
-	static const uint8_t EVENT_NOTICE_ROPE = (1<<0);
-
 	bool should_show_rope(){
-		bool rope_has_been_noticed = local_event_tags & EVENT_NOTICE_ROPE;
+		bool rope_has_been_noticed = room_state.test(ROOM_FLAG_F0_LIGHT_ROOM_NOTICE_ROPE);
 		bool rope_is_available = !player.has_item(PLAYER_ITEM_ID_ROPE);
 
 		return ( rope_has_been_noticed && rope_is_available );
@@ -538,483 +1444,194 @@ private:
 		return (crystal_is_available && crystal_has_not_been_used);
 	}
 
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Stairs up")
-			, F("Barrels")
-			, F("Well")
-			, F("Rope")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
+	// The rope is the last object.
+	uint8_t real_load_object_menu(text_id *menu_texts, uint8_t menu_length){
+		uint8_t object_list_length = get_object_count();
 		object_list_length --;
 
 		if (should_show_rope())
 			object_list_length++;
 
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
+		return load_room_object_menu(menu_texts, menu_length, object_list_length);
 	}
 
-	const __FlashStringHelper* shimmer_in_water(){
-		return F("There seems to be water in the well. Something glitters in the light under the shallow water.");
+	text_id shimmer_in_water(){
+		return TEXT_F0_STORE_SHIMMER_IN_WATER;
 	}
 
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The stairs lead up to the light of the entrance room.")
-			, F("The barrels contain grain.")
-			, F("There seems to be water in the well.")
-			, F("The long length of rope is made of hemp and looks strong.")
-			, F("One of the barrels contains some rope.")
-			};
-
+	void real_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
 		switch (selected_action){
 		case ACTION_ID_LOOK:
 			if (object_selected == 1){
 				if ( !player.has_item(PLAYER_ITEM_ID_ROPE) && !player.has_achievement(EVENT_TAG_ID_ROPE_TIED_AROUND_WELL)){
-					local_event_tags |= EVENT_NOTICE_ROPE;
-					object_selected = 4;
+					room_state.set(ROOM_FLAG_F0_LIGHT_ROOM_NOTICE_ROPE);
+					return build_event<event>(next_event, TEXT_F0_STORE_NOTICE_ROPE);
 				}
 			}
 			else if (object_selected == 2){
 				if ( should_show_crystal() )
-					return event(shimmer_in_water());
+					return build_event<event>(next_event, shimmer_in_water());
 			}
-			return event(look_descriptions[object_selected]);
+			break;
 		case ACTION_ID_USE:
-			if (object_selected == 0)
-				return create_f1_main_hall_event();
-			else if (object_selected == 3 && player.has_achievement(EVENT_TAG_ID_ROPE_TIED_AROUND_WELL))
-				return f0_in_the_well_event();
+			if (object_selected == 3 && player.has_achievement(EVENT_TAG_ID_ROPE_TIED_AROUND_WELL))
+				return build_event<room_event>(next_event, ROOM_ID_F0_IN_THE_WELL);
 			break;
 		case ACTION_ID_TAKE:
 			if (object_selected == 3){
 				player.add_item(PLAYER_ITEM_ID_ROPE);
 				player.remove_achievement(EVENT_TAG_ID_ROPE_TIED_AROUND_WELL);
-				return event(F("You gather the rope."));
+				return build_event<event>(next_event, TEXT_F0_STORE_TAKE_ROPE);
 			}
 			break;
 		}
-		return event();
+		return room_event::real_process_action_on_object(selected_action, object_selected, next_event);
 	}
 
-	event real_process_item_on_object(player_item_id selected_item, uint8_t object_selected){
+	void real_process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event){
 		if (selected_item == PLAYER_ITEM_ID_ROPE){
 			if (object_selected == 2){
 				player.add_achievement(EVENT_TAG_ID_ROPE_TIED_AROUND_WELL);
-				player.remove_item(PLAYER_ITEM_ID_ROPE);
-				return event(F("You tie the rope around the well."));
-			}
-		}
-		else if (selected_item == PLAYER_ITEM_ID_OIL_LAMP){
-			if (object_selected == 2){
-				if ( should_show_crystal() )
-					return event(shimmer_in_water());
-				else
-					return event(F("The water is still."));
-			}
-		}
-		return event();
-	}
-};
-
-class f0_monster_dies_event : public event {
-public:
-	f0_monster_dies_event(){
-		description = (const char *)F("The bat flies towards you, fangs ready to bite you. You quickly draw your sword and swing at the creature. The sword cuts the creature and the fell beast screeches and bursts into flames before evaporating into mist.");
-		internal_get_continue_event = static_cast<get_prelude_event_type>(&real_get_continue_event);
-		return_to_previous_event = false;
-	}
-
-private:
-	event real_get_continue_event(){
-		return f0_light_room_event();
-	}
-};
-
-class f0_monster_attacks_event : public event {
-public:
-	f0_monster_attacks_event(){
-		description = f0_hall_description;
-		allow_actions = true;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_process_item_on_object = static_cast<process_item_on_object_type>(&real_process_item_on_object);
-		internal_load_description = static_cast<load_description_type>(&real_load_description);
-	}
-
-private:
-	void real_load_description(char *string_to_init, uint8_t max_string_length)
-	{
-		default_load_description(string_to_init, max_string_length);
-		append_progmem_string_to_string(F(" Your light disturbs a large black creature, hanging from the ceiling. The large bat unfolds its wings and attacks you!"), string_to_init, max_string_length);
-	}
-
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Stairs up")
-			, F("Barrels")
-			, F("Well")
-			, F("Large Bat")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
-	}
-
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		switch (selected_action){
-		case ACTION_ID_LOOK:
-			if (object_selected == 3)
-				return event(F("The bat has a five foot wing span and very sharp fangs."));
-			break;
-		}
-		return killed_by_bat_while_distracted();
-	}
-
-	event real_process_item_on_object(player_item_id selected_item, uint8_t object_selected){
-		if (object_selected == 3){
-			if (selected_item == PLAYER_ITEM_ID_SWORD){
-				player.add_achievement(EVENT_TAG_ID_CRYPT_MONSTER_DEAD);
-				return f0_monster_dies_event();
-			}
-			return event();
-		}
-		return killed_by_bat_while_distracted();
-	}
-
-	event killed_by_bat_while_distracted(){
-		return player_dies_event(F("While distracted the bat grabs you and sinks its fangs deep into your neck. Everything goes dark."));
-	}
-};
-
-class f0_dark_room_event : public event {
-public:
-	f0_dark_room_event(){
-		description = (const char *)F("You descend several steps, but it quickly gets too dark to proceed further.");
-		allow_actions = true;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_process_item_on_object = static_cast<process_item_on_object_type>(&real_process_item_on_object);
-	}
-
-private:
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Stairs up")
-			, F("Darkness")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
-	}
-
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The stairs lead up to the light of the entrance room.")
-			, F("This area is too dark to see anything.")
-			};
-
-		switch (selected_action){
-		case ACTION_ID_LOOK:
-			return event(look_descriptions[object_selected]);
-		case ACTION_ID_USE:
-			if (object_selected == 0)
-				return create_f1_main_hall_event();
+				player.remove_item(PLAYER_ITEM_ID_ROPE);
+				return build_event<event>(next_event, TEXT_F0_STORE_TIE_ROPE);
+			}
 		}
-		return event();
-	}
-
-	event real_process_item_on_object(player_item_id selected_item, uint8_t object_selected){
-		switch (selected_item){
-		case PLAYER_ITEM_ID_OIL_LAMP:
-			if (object_selected == 1){
-				if (player.has_achievement(EVENT_TAG_ID_CRYPT_MONSTER_DEAD))
-					return f0_light_room_event();
+		else if (selected_item == PLAYER_ITEM_ID_OIL_LAMP){
+			if (object_selected == 2){
+				if ( should_show_crystal() )
+					return build_event<event>(next_event, shimmer_in_water());
 				else
-					return f0_monster_attacks_event();
+					return build_event<event>(next_event, TEXT_F0_STORE_WATER_STILL);
 			}
 		}
-		return event();
+		return build_event<event>(next_event);
 	}
 };
 
-class f4_open_chest_with_copied_key : public event {
-public:
-	f4_open_chest_with_copied_key(){
-		description = open_chest_description;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_load_description = static_cast<load_description_type>(&real_load_description);
-		allow_actions = true;
-	}
+class f0_monster_attacks_event : public room_event {
+	friend class event;
 
 private:
-	void real_load_description(char *string_to_init, uint8_t max_string_length)
+	void real_load_description(description_type& description_to_init)
 	{
-		default_load_description(string_to_init, max_string_length);
-		append_progmem_string_to_string(F("two vials, each containing a different coloured liquid."), string_to_init, max_string_length);
-	}
-
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Pink Vial")
-			, F("Yellow Vial")
-			, F("Door")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
+		default_load_description(description_to_init);
+		description_to_init.append(TEXT_F0_BAT_DISTURBED);
 	}
 
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The small vial contains a pink liquid.")
-			, F("The small vial contains a yellow liquid.")
-			, F("The door is shut tight. You cannot open it.")
-			};
-
+	void real_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
 		switch (selected_action){
 		case ACTION_ID_LOOK:
-			return event(look_descriptions[object_selected]);
-		case ACTION_ID_USE:
-		case ACTION_ID_TAKE:
-			switch (object_selected){
-			case 0:
-				return player_dies_event((const __FlashStringHelper*)drink_pink_vial);
-			case 1:
-				return drinks_yellow_vial_event();
-			}
-			return event(look_descriptions[object_selected]);
+			if (object_selected == 3)
+				return room_event::real_process_action_on_object(selected_action, object_selected, next_event);
 			break;
 		}
-		return event();
-	}
-};
-
-class f4_open_chest_with_modified_key : public event {
-public:
-	f4_open_chest_with_modified_key(){
-		description = open_chest_description;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_load_description = static_cast<load_description_type>(&real_load_description);
-		allow_actions = true;
+		return killed_by_bat_while_distracted(next_event);
 	}
 
-private:
-	void real_load_description(char *string_to_init, uint8_t max_string_length)
-	{
-		default_load_description(string_to_init, max_string_length);
-		append_progmem_string_to_string(F("a vial containing a pink liquid."), string_to_init, max_string_length);
+	void real_process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event){
+		if (object_selected == 3){
+			if (selected_item == PLAYER_ITEM_ID_SWORD){
+				player.add_achievement(EVENT_TAG_ID_CRYPT_MONSTER_DEAD);
+				return build_event<f0_monster_dies_event>(next_event);
+			}
+			return build_event<event>(next_event);
+		}
+		return killed_by_bat_while_distracted(next_event);
 	}
 
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Pink Vial")
-			, F("Door")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
+	void killed_by_bat_while_distracted(event& next_event){
+		return build_event<player_dies_event>(next_event, TEXT_F0_BAT_KILLS_PLAYER);
 	}
+};
 
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The small vial contains a pink liquid.")
-			, F("The door is shut tight. You cannot open it.")
-			};
+class f0_dark_room_event : public room_event {
+	friend class event;
 
-		switch (selected_action){
-		case ACTION_ID_LOOK:
-			return event(look_descriptions[object_selected]);
-		case ACTION_ID_USE:
-		case ACTION_ID_TAKE:
-			switch (object_selected){
-			case 0:
-				return player_dies_event((const __FlashStringHelper*)drink_pink_vial);
+private:
+	void real_process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event){
+		switch (selected_item){
+		case PLAYER_ITEM_ID_OIL_LAMP:
+			if (object_selected == 1){
+				if (player.has_achievement(EVENT_TAG_ID_CRYPT_MONSTER_DEAD))
+					return build_event<room_event>(next_event, ROOM_ID_F0_LIGHT_ROOM);
+				else
+					return build_event<room_event>(next_event, ROOM_ID_F0_MONSTER_ATTACKS);
 			}
-			return event(look_descriptions[object_selected]);
-			break;
 		}
-		return event();
+		return build_event<event>(next_event);
 	}
 };
 
-class f4_open_chest_with_chest_key : public event {
-public:
-	f4_open_chest_with_chest_key(){
-		description = open_chest_description;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_load_description = static_cast<load_description_type>(&real_load_description);
-		allow_actions = true;
-	}
+// All three chest rooms: the first vial is always the pink one, and only the
+// copied key finds the yellow vial as well.
+class f4_open_chest_event : public room_event {
+	friend class event;
 
 private:
-	void real_load_description(char *string_to_init, uint8_t max_string_length)
-	{
-		default_load_description(string_to_init, max_string_length);
-		append_progmem_string_to_string(F("a vial containing a pink liquid."), string_to_init, max_string_length);
+	bool yellow_vial_is_in_chest(){
+		return get_room() == ROOM_ID_F4_OPEN_CHEST_WITH_COPIED_KEY;
 	}
 
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Vial")
-			, F("Door")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
+	void real_load_description(description_type& description_to_init)
+	{
+		default_load_description(description_to_init);
+		if (yellow_vial_is_in_chest())
+			description_to_init.append(TEXT_F4_CHEST_TWO_VIALS);
+		else
+			description_to_init.append(TEXT_F4_CHEST_ONE_VIAL);
 	}
 
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The small vial contains a pink liquid.")
-			, F("The door is shut tight. You cannot open it.")
-			};
-
+	void real_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
 		switch (selected_action){
-		case ACTION_ID_LOOK:
-			return event(look_descriptions[object_selected]);
 		case ACTION_ID_USE:
 		case ACTION_ID_TAKE:
-			switch (object_selected){
-			case 0:
-				return player_dies_event((const __FlashStringHelper*)drink_pink_vial);
-			}
-			return event(look_descriptions[object_selected]);
+			if (object_selected == 0)
+				return build_event<player_dies_event>(next_event, TEXT_DRINK_PINK_VIAL);
+			if (object_selected == 1 && yellow_vial_is_in_chest())
+				return build_event<drinks_yellow_vial_event>(next_event);
 			break;
 		}
-		return event();
+		return room_event::real_process_action_on_object(selected_action, object_selected, next_event);
 	}
 };
 
-class f4_main_hall_event : public event {
-public:
-	f4_main_hall_event(){
-		description = (const char *)F("Four arrow-slit windows cast a dim light in this room. A chest stands in the middle of the room.");
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_process_item_on_object = static_cast<process_item_on_object_type>(&real_process_item_on_object);
-		allow_actions = true;
-	}
+class f4_main_hall_event : public room_event {
+	friend class event;
 
 private:
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Chest")
-			, F("Stairs down")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
-	}
-
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The chest is sturdy with iron bands and a lock built in. Could this have the cure you are looking for?")
-			, F("The stairs lead down to the floor below.")
-			};
-
-		switch (selected_action){
-		case ACTION_ID_LOOK:
-			return event(look_descriptions[object_selected]);
-		case ACTION_ID_USE:
-			switch (object_selected){
-			case 1:
-				return create_f3_main_hall_event();
-			}
-			break;
-		case ACTION_ID_TAKE:
-			switch (object_selected){
-			case 0:
-				return event(F("You try to move the chest, but it won't budge. It is like it is held in place by some force."));
-			}
-			break;
-		}
-		return event();
-	}
-
-	event real_process_item_on_object(player_item_id selected_item, uint8_t object_selected){
+	void real_process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event){
 		if (object_selected == 0){
 			if (selected_item == PLAYER_ITEM_ID_CHEST_KEY)
-				return f4_open_chest_with_chest_key();
+				return build_event<room_event>(next_event, ROOM_ID_F4_OPEN_CHEST_WITH_CHEST_KEY);
 			if (selected_item == PLAYER_ITEM_ID_MOD_CHEST_KEY)
-				return f4_open_chest_with_modified_key();
+				return build_event<room_event>(next_event, ROOM_ID_F4_OPEN_CHEST_WITH_MODIFIED_KEY);
 			if (selected_item == PLAYER_ITEM_ID_COPIED_KEY)
-				return f4_open_chest_with_copied_key();
+				return build_event<room_event>(next_event, ROOM_ID_F4_OPEN_CHEST_WITH_COPIED_KEY);
 		}
-		return event();
-	}
-};
-
-class f4_door_unlocked_event : public event {
-public:
-	f4_door_unlocked_event(){
-		description = (const char *)F("You place the crystal in the door. The magic circle and the symbols glow faintly and hum with energy. With a loud grinding sound, the door swings open to reveal the room beyond.");
-		internal_get_continue_event = static_cast<get_prelude_event_type>(&real_get_continue_event);
-		return_to_previous_event = false;
-	}
-
-private:
-	event real_get_continue_event(){
-		return f4_main_hall_event();
+		return build_event<event>(next_event);
 	}
 };
 
-class f4_main_hall_locked_event : public event {
-public:
-	f4_main_hall_locked_event(){
-		description = (const char *)F("You ascend the stairs to the next floor. A solid oak door awaits you at the top of the stairs.");
-		allow_actions = true;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_process_item_on_object = static_cast<process_item_on_object_type>(&real_process_item_on_object);
-	}
+class f4_main_hall_locked_event : public room_event {
+	friend class event;
 
 private:
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Stairs Down")
-			, F("Door")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
-	}
-
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The stairs lead down to the hall below.")
-			, F("The solid oak door is sturdy and is locked. A magic circle with strange symbols mark the door. In the centre is a diamond shaped hole.")
-			};
-
-		switch (selected_action){
-		case ACTION_ID_LOOK:
-			return event(look_descriptions[object_selected]);
-		case ACTION_ID_USE:
-			if (object_selected == 0)
-				return create_f3_main_hall_event();
-		}
-		return event();
-	}
-
-	event real_process_item_on_object(player_item_id selected_item, uint8_t object_selected){
+	void real_process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event){
 		if (selected_item == PLAYER_ITEM_ID_MASTER_KEY)
 			if (object_selected == 1){
 				player.add_achievement(EVENT_TAG_ID_MASTER_ROOM_DOOR_OPENED);
-				return f4_door_unlocked_event();
+				return build_event<f4_door_unlocked_event>(next_event);
 			}
-		return event();
+		return build_event<event>(next_event);
 	}
 };
 
-class f3_main_hall_event : public event {
-public:
-	f3_main_hall_event(){
-		description = (const char *)F("At opposite ends of the room are stairs; one leads up, one leads down. There is a table of alchemical instruments and broken glass.");
-		allow_actions = true;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_process_item_on_object = static_cast<process_item_on_object_type>(&real_process_item_on_object);
-		internal_load_description = static_cast<load_description_type>(&real_load_description);
-	}
+class f3_main_hall_event : public room_event {
+	friend class event;
 
 private:
-	static const uint8_t EVENT_NOTICE_KEY = (1<<0);
+	// The keys placed in the machine are local to the visit, so leaving the
+	// room takes them out again, as the machine's instructions say.
 	static const uint8_t EVENT_CUT_CHEST_KEY = (1<<1);
 	static const uint8_t EVENT_CUT_BLANK_KEY = (1<<2);
 	static const uint8_t EVENT_COPY_CHEST_KEY = (1<<3);
@@ -1024,7 +1641,7 @@ private:
 
 	bool player_can_see_the_key(){
 		bool key_is_available = !player.has_item(PLAYER_ITEM_ID_CHEST_KEY);
-		bool key_has_been_noticed = (local_event_tags & EVENT_NOTICE_KEY);
+		bool key_has_been_noticed = room_state.test(ROOM_FLAG_F3_MAIN_HALL_NOTICE_KEY);
 
 		bool key_visible = key_is_available && key_has_been_noticed;
 
@@ -1053,74 +1670,58 @@ private:
 		}
 	}
 
-	void real_load_description(char *string_to_init, uint8_t max_string_length)
+	void real_load_description(description_type& description_to_init)
 	{
-		default_load_description(string_to_init, max_string_length);
+		default_load_description(description_to_init);
 
 		if (player.has_achievement(EVENT_TAG_ID_UNCOVERED_KEY_MACHINE))
-			append_progmem_string_to_string(F(" Next to it is a key-cutting machine."), string_to_init, max_string_length);
+			description_to_init.append(TEXT_F3_HALL_KEY_MACHINE_VISIBLE);
 		else
-			append_progmem_string_to_string(F(" Next to it a dusty curtain covers something large."), string_to_init, max_string_length);
-	}
-
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Table")
-			, F("Curtain")
-			, F("Stairs up")
-			, F("Stairs down")
-			, F("Key")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		object_list_length --;
+			description_to_init.append(TEXT_F3_HALL_CURTAIN_VISIBLE);
+	}
 
-		if (player.has_achievement(EVENT_TAG_ID_UNCOVERED_KEY_MACHINE))
-			object_list[1] = F("Key Machine");
+	// The key is the last object, and the curtain becomes the key machine once
+	// it is taken down.
+	uint8_t real_load_object_menu(text_id *menu_texts, uint8_t menu_length){
+		uint8_t object_list_length = get_object_count();
+		object_list_length --;
 
 		if (player_can_see_the_key())
 			object_list_length++;
 
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
-	}
-
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The table is stained with spilled chemicals. The tools and instruments are rusted and broken. In amongst the mess there is a copper key.")
-			, F("The elegant red curtain with gold trim completely covers something large and box shaped.")
-			, F("The stairs wind up to the next floor.")
-			, F("The stairs lead down to the faint light of the hall below.")
-			, F("The key is small and made of copper. It has an elegant floral pattern on the handle.")
-			, F("The table is stained with spilled chemicals. The tools and instruments are rusted and broken.")
-			};
+		uint8_t object_count = load_room_object_menu(menu_texts, menu_length, object_list_length);
 
 		if (player.has_achievement(EVENT_TAG_ID_UNCOVERED_KEY_MACHINE))
-			look_descriptions[1] = F("The key cutting machine seems to take first the key you wish to copy and then the cut you wish to cut.");
+			menu_texts[1] = TEXT_OBJECT_KEY_MACHINE;
+		return object_count;
+	}
 
+	void real_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
 		switch (selected_action){
 		case ACTION_ID_LOOK:
 			if (object_selected == 0){
+				room_state.set(ROOM_FLAG_F3_MAIN_HALL_NOTICE_KEY);
 				if (player.has_item(PLAYER_ITEM_ID_CHEST_KEY))
-					object_selected = 5;
-				local_event_tags |= EVENT_NOTICE_KEY;
+					return build_event<event>(next_event, TEXT_F3_HALL_LOOK_TABLE);
 			}
-			return event(look_descriptions[object_selected]);
+			if (object_selected == 1 && player.has_achievement(EVENT_TAG_ID_UNCOVERED_KEY_MACHINE))
+				return build_event<event>(next_event, TEXT_F3_HALL_LOOK_KEY_MACHINE);
+			break;
 		case ACTION_ID_USE:
 			switch (object_selected){
 			case 2:
 				if (player.has_achievement(EVENT_TAG_ID_MASTER_ROOM_DOOR_OPENED))
-					return f4_main_hall_event();
+					return build_event<room_event>(next_event, ROOM_ID_F4_MAIN_HALL);
 				else
-					return f4_main_hall_locked_event();
-			case 3:
-				return create_f2_main_hall_event();
+					return build_event<room_event>(next_event, ROOM_ID_F4_MAIN_HALL_LOCKED);
 			case 1:
 				if (key_cutter_is_ready()){
 					make_new_key();
-					return event(F("You use the machine and get a new key."));
+					return build_event<event>(next_event, TEXT_F3_HALL_MACHINE_MAKES_KEY);
 				}
 				else{
 					if (player.has_achievement(EVENT_TAG_ID_UNCOVERED_KEY_MACHINE))
-						return event(F("First place a key to copy then one to cut. To reset choices, leave and return to this room."));
+						return build_event<event>(next_event, TEXT_F3_HALL_MACHINE_INSTRUCTIONS);
 				}
 			}
 			break;
@@ -1130,70 +1731,59 @@ private:
 				if (!player.has_achievement(EVENT_TAG_ID_UNCOVERED_KEY_MACHINE)){
 					player.add_achievement(EVENT_TAG_ID_UNCOVERED_KEY_MACHINE);
 					player.add_item(PLAYER_ITEM_ID_SHEET);
-					return event(F("You collect the curtain and uncover what seems to be a key cutting machine."));
+					return build_event<event>(next_event, TEXT_F3_HALL_TAKE_CURTAIN);
 				}
 				break;
 			case 4:
 				player.add_item(PLAYER_ITEM_ID_CHEST_KEY);
-				return event(F("You pick up the small copper key."));
+				return build_event<event>(next_event, TEXT_F3_HALL_TAKE_KEY);
 			}
 			break;
 		}
-		return event();
+		return room_event::real_process_action_on_object(selected_action, object_selected, next_event);
 	}
 
-	event real_process_item_on_object(player_item_id selected_item, uint8_t object_selected){
+	void real_process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event){
 		switch (object_selected){
 		case 1:
 			if (player.has_achievement(EVENT_TAG_ID_UNCOVERED_KEY_MACHINE)){
 				if (!(local_event_tags & EVENT_COPY_KEY_PLACED)){
 					if (selected_item == PLAYER_ITEM_ID_CHEST_KEY)
-						return event(F("This key looks okay. It doesn't need copying."));
+						return build_event<event>(next_event, TEXT_F3_HALL_KEY_NEEDS_NO_COPY);
 
 					if (selected_item == PLAYER_ITEM_ID_BROKEN_KEY){
 						local_event_tags |= EVENT_COPY_BROKEN_KEY;
-						return event(F("You place the broken key in the machine for copying."));
+						return build_event<event>(next_event, TEXT_F3_HALL_PLACE_BROKEN_KEY);
 					}
 				}
 				else if (!(local_event_tags & EVENT_CUT_KEY_PLACED)){
 					if (selected_item == PLAYER_ITEM_ID_CHEST_KEY){
 						local_event_tags |= EVENT_CUT_CHEST_KEY;
-						return event(F("You place the copper key in the machine for cutting."));
+						return build_event<event>(next_event, TEXT_F3_HALL_PLACE_COPPER_KEY);
 					}
 					if (selected_item == PLAYER_ITEM_ID_BLANK_KEY){
 						local_event_tags |= EVENT_CUT_BLANK_KEY;
-						return event(F("You place the blank key in the machine for cutting."));
+						return build_event<event>(next_event, TEXT_F3_HALL_PLACE_BLANK_KEY);
 					}
 				}
 			}
 		}
-		return event();
+		return build_event<event>(next_event);
 	}
 };
 
-class f2_main_hall_event : public event {
-public:
-	f2_main_hall_event(){
-		description = (const char *)F("A barred window casts a ray of light over a statue of a knightly angel. Stairs continue to lead up as well as down.");
-		allow_actions = true;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
-		internal_process_item_on_object = static_cast<process_item_on_object_type>(&real_process_item_on_object);
-		internal_load_description = static_cast<load_description_type>(&real_load_description);
-	}
+class f2_main_hall_event : public room_event {
+	friend class event;
 
 private:
-	void real_load_description(char *string_to_init, uint8_t max_string_length)
+	void real_load_description(description_type& description_to_init)
 	{
-		default_load_description(string_to_init, max_string_length);
+		default_load_description(description_to_init);
 
 		if ( sword_is_on_ground() )
-			append_progmem_string_to_string(F(" The sword is lying on the ground before the statue."), string_to_init, max_string_length);
+			description_to_init.append(TEXT_F2_HALL_SWORD_ON_GROUND);
 	}
 
-	static const uint8_t EVENT_NOTICE_SWORD = (1<<0);
-	static const uint8_t EVENT_NOTICE_KEY = (1<<1);
-
 	enum event_object_ids
 		{ EVENT_OBJECT_WINDOW
 		, EVENT_OBJECT_STATUE
@@ -1201,8 +1791,6 @@ private:
 		, EVENT_OBJECT_STAIRS_DOWN
 		, EVENT_OBJECT_SILVER_SWORD
 		, EVENT_OBJECT_BROKEN_KEY
-		, EVENT_OBJECT_SWORD_ON_FLOOR = EVENT_OBJECT_BROKEN_KEY
-		, EVENT_OBJECT_ANGEL_CHANGED
 		};
 
 	bool sword_is_on_ground(){
@@ -1214,7 +1802,7 @@ private:
 	bool sword_should_be_in_object_list(){
 		bool sword_is_released = player.has_achievement(EVENT_TAG_ID_RELEASED_SWORD);
 		bool sword_is_available = !player.has_item(PLAYER_ITEM_ID_SWORD);
-		bool sword_has_been_noticed = (local_event_tags & EVENT_NOTICE_SWORD);
+		bool sword_has_been_noticed = room_state.test(ROOM_FLAG_F2_MAIN_HALL_NOTICE_SWORD);
 
 		bool show_sword = sword_is_available && (sword_is_released || sword_has_been_noticed);
 
@@ -1233,23 +1821,16 @@ private:
 
 	bool key_should_be_in_object_list(){
 		bool key_is_accessible = player_can_access_key();
-		bool key_has_been_noticed = (local_event_tags & EVENT_NOTICE_KEY);
+		bool key_has_been_noticed = room_state.test(ROOM_FLAG_F2_MAIN_HALL_NOTICE_KEY);
 
 		bool show_key = key_is_accessible && key_has_been_noticed;
 
 		return show_key;
 	}
 
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Window")
-			, F("Angel Statue")
-			, F("Stairs up")
-			, F("Stairs down")
-			, F("Silver Sword")
-			, F("Key")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
+	// The sword and the key are the last two objects.
+	uint8_t real_load_object_menu(text_id *menu_texts, uint8_t menu_length){
+		uint8_t object_list_length = get_object_count();
 		object_list_length -= 2;
 
 		if ( sword_should_be_in_object_list() )
@@ -1257,173 +1838,755 @@ private:
 		if ( key_should_be_in_object_list() )
 			object_list_length++;
 
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
+		return load_room_object_menu(menu_texts, menu_length, object_list_length);
 	}
 
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The lonely window has rusted iron bars. A broken rail clings to the wall above the window.")
-			, F("The statue is of an angelic knight kneeling before the light of the window. One hand on its breast plate the other holding a silver sword up-side-down.")
-			, F("The stairs lead up to the next floor.")
-			, F("Stairs lead down to a warm glow.")
-			, F("The sword glitters beautifully in the light. It carries a sharp edge.")
-			, F("The sword is lying on the stone floor, light reflects off it onto the wall, which becomes translucent revealing a cache. In the cache you see a key.")
-			, F("The statue is of an angelic knight kneeling before the window. One hand on its breast plate the other reaching out in despair.")
-			};
-
+	void real_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
 		switch (selected_action){
 		case ACTION_ID_LOOK:
 			if (object_selected == EVENT_OBJECT_STATUE){
 				if ( !player.has_item(PLAYER_ITEM_ID_SWORD) )
-					local_event_tags |= EVENT_NOTICE_SWORD;
+					room_state.set(ROOM_FLAG_F2_MAIN_HALL_NOTICE_SWORD);
 				if ( player.has_achievement(EVENT_TAG_ID_RELEASED_SWORD) )
-					object_selected = EVENT_OBJECT_ANGEL_CHANGED;
+					return build_event<event>(next_event, TEXT_F2_HALL_LOOK_STATUE_CHANGED);
 			}
 			if (object_selected == EVENT_OBJECT_SILVER_SWORD){
 				if ( player_can_access_key() ){
-					local_event_tags |= EVENT_NOTICE_KEY;
-					object_selected = EVENT_OBJECT_SWORD_ON_FLOOR;
+					room_state.set(ROOM_FLAG_F2_MAIN_HALL_NOTICE_KEY);
+					return build_event<event>(next_event, TEXT_F2_HALL_LOOK_SWORD_ON_FLOOR);
 				}
 			}
-			return event(look_descriptions[object_selected]);
-		case ACTION_ID_USE:
-			switch (object_selected){
-			case EVENT_OBJECT_STAIRS_UP:
-				return f3_main_hall_event();
-			case EVENT_OBJECT_STAIRS_DOWN:
-				return create_f1_main_hall_event();
-			}
 			break;
 		case ACTION_ID_TAKE:
 			switch (object_selected){
 			case EVENT_OBJECT_SILVER_SWORD:
 				if ( player.has_achievement(EVENT_TAG_ID_RELEASED_SWORD) ){
 					player.add_item(PLAYER_ITEM_ID_SWORD);
-					return event(F("The sword is in perfect condition and glistens silver in the light."));
+					return build_event<event>(next_event, TEXT_F2_HALL_TAKE_SWORD);
 				}else
-					return event(F("You are unable to release the sword from the statue's grip."));
+					return build_event<event>(next_event, TEXT_F2_HALL_SWORD_STUCK);
 				break;
 			case EVENT_OBJECT_BROKEN_KEY:
 				player.add_item(PLAYER_ITEM_ID_BROKEN_KEY);
-				return event(F("The key's handle is broken off and missing."));
+				return build_event<event>(next_event, TEXT_F2_HALL_TAKE_KEY);
 			}
 			break;
 		}
-		return event();
+		return room_event::real_process_action_on_object(selected_action, object_selected, next_event);
 	}
 
-	event real_process_item_on_object(player_item_id selected_item, uint8_t object_selected){
+	void real_process_item_on_object(player_item_id selected_item, uint8_t object_selected, event& next_event){
 		switch (selected_item){
 		case PLAYER_ITEM_ID_SHEET:
 			if (object_selected == EVENT_OBJECT_WINDOW){
 				player.add_achievement(EVENT_TAG_ID_RELEASED_SWORD);
 				player.remove_item(PLAYER_ITEM_ID_SHEET);
-				return event(F("You cover the window with the curtain. The room is cloaked in darkness. A high pitch scream echoes in the room and then a clang of metal. You drop the curtain to see the sword is now lying on the floor."));
+				return build_event<event>(next_event, TEXT_F2_HALL_COVER_WINDOW);
+			}
+			else if (object_selected == EVENT_OBJECT_STATUE)
+				return build_event<event>(next_event, TEXT_F2_HALL_CURTAIN_TOO_SMALL);
+		}
+		return build_event<event>(next_event);
+	}
+};
+
+class f1_main_hall_event : public room_event {
+	friend class event;
+
+private:
+	void real_process_action_on_object(uint8_t selected_action, uint8_t object_selected, event& next_event){
+		switch (selected_action){
+		case ACTION_ID_TAKE:
+			switch (object_selected){
+			case 3:
+				if ( !(player.has_item(PLAYER_ITEM_ID_OIL_LAMP)) ){
+					player.add_item(PLAYER_ITEM_ID_OIL_LAMP);
+					return build_event<event>(next_event, TEXT_F1_HALL_TAKE_LAMP);
+				}
+				else
+					return build_event<event>(next_event, TEXT_F1_HALL_HAVE_LAMP);
+			}
+			break;
+		}
+		return room_event::real_process_action_on_object(selected_action, object_selected, next_event);
+	}
+};
+
+// The handlers of one of the rooms' own classes. Those it does not define are
+// room_event's.
+#define ROOM_BEHAVIOUR(room_class) \
+	{ static_cast<load_description_type>(&room_class::real_load_description) \
+	, static_cast<load_object_menu_type>(&room_class::real_load_object_menu) \
+	, static_cast<process_action_on_object_type>(&room_class::real_process_action_on_object) \
+	, static_cast<process_item_on_object_type>(&room_class::real_process_item_on_object) \
+	, &event::default_get_continue_event \
+	}
+
+// One entry per event_type_id, in order, then one per room in ROOM_ID order.
+// Sub-classes befriend event so their handlers can be listed here.
+const event_behaviour_type event::behaviours[] PROGMEM =
+	// EVENT_TYPE_ID_NOTHING
+	{ { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , &event::default_get_continue_event
+	  }
+	// EVENT_TYPE_ID_INTRO
+	, { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , static_cast<get_prelude_event_type>(&intro_event::real_get_continue_event)
+	  }
+	// EVENT_TYPE_ID_RESURRECT
+	, { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , static_cast<get_prelude_event_type>(&resurrect_event::real_get_continue_event)
+	  }
+	// EVENT_TYPE_ID_RETURN_TO_GAME
+	, { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , static_cast<get_prelude_event_type>(&return_to_game::real_get_continue_event)
+	  }
+	// EVENT_TYPE_ID_WIN
+	, { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , static_cast<get_prelude_event_type>(&win_event::real_get_continue_event)
+	  }
+	// EVENT_TYPE_ID_PLAYER_DIES
+	, { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , static_cast<get_prelude_event_type>(&player_dies_event::real_get_continue_event)
+	  }
+	// EVENT_TYPE_ID_DRINKS_YELLOW_VIAL
+	, { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , static_cast<get_prelude_event_type>(&drinks_yellow_vial_event::real_get_continue_event)
+	  }
+	// EVENT_TYPE_ID_F0_MONSTER_DIES
+	, { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , static_cast<get_prelude_event_type>(&f0_monster_dies_event::real_get_continue_event)
+	  }
+	// EVENT_TYPE_ID_F4_DOOR_UNLOCKED
+	, { &event::default_load_description
+	  , &event::default_load_object_menu
+	  , &event::default_process_action_on_object
+	  , &event::default_process_item_on_object
+	  , static_cast<get_prelude_event_type>(&f4_door_unlocked_event::real_get_continue_event)
+	  }
+	// ROOM_ID_F1_MAIN_HALL
+	, ROOM_BEHAVIOUR(f1_main_hall_event)
+	// ROOM_ID_F2_MAIN_HALL
+	, ROOM_BEHAVIOUR(f2_main_hall_event)
+	// ROOM_ID_F3_MAIN_HALL
+	, ROOM_BEHAVIOUR(f3_main_hall_event)
+	// ROOM_ID_F4_MAIN_HALL_LOCKED
+	, ROOM_BEHAVIOUR(f4_main_hall_locked_event)
+	// ROOM_ID_F4_MAIN_HALL
+	, ROOM_BEHAVIOUR(f4_main_hall_event)
+	// ROOM_ID_F4_OPEN_CHEST_WITH_CHEST_KEY
+	, ROOM_BEHAVIOUR(f4_open_chest_event)
+	// ROOM_ID_F4_OPEN_CHEST_WITH_MODIFIED_KEY
+	, ROOM_BEHAVIOUR(f4_open_chest_event)
+	// ROOM_ID_F4_OPEN_CHEST_WITH_COPIED_KEY
+	, ROOM_BEHAVIOUR(f4_open_chest_event)
+	// ROOM_ID_F0_DARK_ROOM
+	, ROOM_BEHAVIOUR(f0_dark_room_event)
+	// ROOM_ID_F0_LIGHT_ROOM
+	, ROOM_BEHAVIOUR(f0_light_room_event)
+	// ROOM_ID_F0_MONSTER_ATTACKS
+	, ROOM_BEHAVIOUR(f0_monster_attacks_event)
+	// ROOM_ID_F0_IN_THE_WELL
+	, ROOM_BEHAVIOUR(f0_in_the_well_event)
+	};
+
+static_assert(sizeof(event::behaviours) / sizeof(event::behaviours[0]) == EVENT_TYPE_ID_COUNT, "event::behaviours needs one entry per event type and room");
+
+struct starting_event : public intro_event
+{};
+
+
+// ------------------------------------------------
+// Saved games
+// ------------------------------------------------
+
+// The game saves itself to EEPROM whenever the player is back in a room and
+// something has changed. A slot is a ring of records, and each save goes in
+// the record after the newest one, so that the writes wear the whole ring
+// evenly rather than one place. A record is
+//
+//   sequence   one more than the sequence of the record it replaces
+//   version    SAVE_VERSION; records of any other version are ignored
+//   state      the game state, bit-packed by save_state_type
+//   check      a checksum of the bytes before it, written last
+//
+// The newest record is the valid one with the highest sequence, so a save cut
+// short by a reset leaves the one before it in place.
+
+#define SAVE_VERSION 2
+#define SAVE_SLOT_COUNT 3
+#define SAVE_RECORDS_PER_SLOT 32
+#define SAVE_RECORD_SIZE (SAVE_STATE_SIZE + 3)
+#define SAVE_SLOT_SIZE (SAVE_RECORDS_PER_SLOT * SAVE_RECORD_SIZE)
+#define SAVE_EEPROM_START 0
+
+#define SAVE_RECORD_NONE 0xff
+
+// The slot the game saves itself in, and the only one it uses. The others can
+// be reached only through save() and load(): nothing in play offers them, and
+// a game starts afresh only after the player dies or wins.
+#define SAVE_SLOT_PLAYER 0
+
+#define SAVE_ROOM_BITS 4
+#define SAVE_EVENT_TAG_BITS 8
+#define SAVE_ITEM_BITS PLAYER_ITEM_COUNT
+#define SAVE_STATE_BITS (SAVE_ROOM_BITS + 2 * SAVE_EVENT_TAG_BITS + SAVE_ITEM_BITS + ROOM_FLAG_COUNT)
+#define SAVE_STATE_SIZE ((SAVE_STATE_BITS + 7) / 8)
+
+// The size of the state when SAVE_VERSION was last changed. A state of any
+// other size moves the records within a slot, so it needs a new version.
+#define SAVE_VERSION_STATE_BITS 35
+
+static_assert(SAVE_EEPROM_START + SAVE_SLOT_COUNT * SAVE_SLOT_SIZE <= E2END + 1, "saved games must fit in EEPROM");
+static_assert(ROOM_COUNT <= (1 << SAVE_ROOM_BITS), "SAVE_ROOM_BITS must hold every room id");
+static_assert(SAVE_STATE_BITS == SAVE_VERSION_STATE_BITS, "the saved state has changed size: change SAVE_VERSION and SAVE_VERSION_STATE_BITS");
+static_assert(SAVE_STATE_BITS <= 255, "save_state_type::bit_pos must count every bit");
+
+// The game state as a string of bits, each value least significant bit first.
+class save_state_type {
+public:
+	save_state_type()
+	: bit_pos( 0 )
+	{
+		memset(bytes, 0, sizeof(bytes));
+	}
+
+	save_state_type(const uint8_t *saved_bytes)
+	: bit_pos( 0 )
+	{
+		memcpy(bytes, saved_bytes, sizeof(bytes));
+	}
+
+	void write_bits(uint16_t value, uint8_t bit_count){
+		for (uint8_t i = 0; i < bit_count; i++, bit_pos++)
+			if (value & ((uint16_t)1 << i))
+				bytes[bit_pos >> 3] |= (1 << (bit_pos & 7));
+	}
+
+	uint16_t read_bits(uint8_t bit_count){
+		uint16_t value = 0;
+		for (uint8_t i = 0; i < bit_count; i++, bit_pos++)
+			if (bytes[bit_pos >> 3] & (1 << (bit_pos & 7)))
+				value |= ((uint16_t)1 << i);
+		return value;
+	}
+
+	template <uint16_t bit_count>
+	void write_set(bit_set_type<bit_count>& set){
+		for (uint16_t bit = 0; bit < bit_count; bit++)
+			write_bits(set.test(bit), 1);
+	}
+
+	template <uint16_t bit_count>
+	void read_set(bit_set_type<bit_count>& set){
+		set.clear_all();
+		for (uint16_t bit = 0; bit < bit_count; bit++)
+			if (read_bits(1))
+				set.set(bit);
+	}
+
+	uint8_t bytes[SAVE_STATE_SIZE];
+
+private:
+	uint8_t bit_pos;
+};
+
+class save_game_type {
+public:
+	save_game_type()
+	: slot( SAVE_SLOT_COUNT )
+	, newest_record( SAVE_RECORD_NONE )
+	, newest_sequence( 0 )
+	{ }
+
+	// Saves the game in the given room, unless it is just as last saved.
+	void save(uint8_t save_slot, event& room){
+		save_state_type state;
+		state.write_bits(room.get_room(), SAVE_ROOM_BITS);
+		state.write_bits(room.get_local_event_tags(), SAVE_EVENT_TAG_BITS);
+		state.write_set(player.get_items());
+		state.write_bits(player.get_achievements(), SAVE_EVENT_TAG_BITS);
+		state.write_set(room_state);
+
+		select_slot(save_slot);
+		if (newest_record != SAVE_RECORD_NONE && memcmp(state.bytes, newest_state, SAVE_STATE_SIZE) == 0)
+			return;
+
+		newest_record = (newest_record + 1) % SAVE_RECORDS_PER_SLOT;
+		newest_sequence++;
+		memcpy(newest_state, state.bytes, SAVE_STATE_SIZE);
+		write_record();
+	}
+
+	// Builds the saved room in next_event, or returns false if the slot holds
+	// no saved game.
+	bool load(uint8_t save_slot, event& next_event){
+		select_slot(save_slot);
+		if (newest_record == SAVE_RECORD_NONE)
+			return false;
+
+		save_state_type state(newest_state);
+		room_id room = state.read_bits(SAVE_ROOM_BITS);
+		uint8_t local_event_tags = state.read_bits(SAVE_EVENT_TAG_BITS);
+		if (room >= ROOM_COUNT)
+			return false;
+
+		state.read_set(player.get_items());
+		player.remove_achievement(EVENT_TAG_ID_ALL);
+		player.add_achievement(state.read_bits(SAVE_EVENT_TAG_BITS));
+		state.read_set(room_state);
+		build_event<room_event>(next_event, room, local_event_tags);
+		return true;
+	}
+
+private:
+	uint8_t slot;
+	uint8_t newest_record;
+	uint8_t newest_sequence;
+	uint8_t newest_state[SAVE_STATE_SIZE];
+
+	uint16_t get_record_address(uint8_t record){
+		return SAVE_EEPROM_START + slot * SAVE_SLOT_SIZE + record * SAVE_RECORD_SIZE;
+	}
+
+	static uint8_t checksum(const uint8_t *bytes, uint8_t length){
+		uint8_t check = 0xa5;
+		for (uint8_t i = 0; i < length; i++)
+			check = ((check << 1) | (check >> 7)) + bytes[i];
+		return check;
+	}
+
+	// Finds the newest record in the slot, once per change of slot.
+	void select_slot(uint8_t new_slot){
+		if (new_slot == slot)
+			return;
+
+		slot = new_slot;
+		newest_record = SAVE_RECORD_NONE;
+
+		for (uint8_t record = 0; record < SAVE_RECORDS_PER_SLOT; record++){
+			uint8_t bytes[SAVE_RECORD_SIZE];
+			uint16_t address = get_record_address(record);
+			for (uint8_t i = 0; i < SAVE_RECORD_SIZE; i++)
+				bytes[i] = EEPROM.read(address + i);
+
+			if (bytes[1] != SAVE_VERSION || bytes[SAVE_RECORD_SIZE - 1] != checksum(bytes, SAVE_RECORD_SIZE - 1))
+				continue;
+
+			// Sequences wrap, but those in a slot are never far apart.
+			if (newest_record == SAVE_RECORD_NONE || (int8_t)(bytes[0] - newest_sequence) > 0){
+				newest_record = record;
+				newest_sequence = bytes[0];
+				memcpy(newest_state, &bytes[2], SAVE_STATE_SIZE);
+			}
+		}
+	}
+
+	void write_record(){
+		uint8_t bytes[SAVE_RECORD_SIZE];
+		bytes[0] = newest_sequence;
+		bytes[1] = SAVE_VERSION;
+		memcpy(&bytes[2], newest_state, SAVE_STATE_SIZE);
+		bytes[SAVE_RECORD_SIZE - 1] = checksum(bytes, SAVE_RECORD_SIZE - 1);
+
+		uint16_t address = get_record_address(newest_record);
+		for (uint8_t i = 0; i < SAVE_RECORD_SIZE; i++)
+			EEPROM.update(address + i, bytes[i]);
+	}
+} save_game;
+
+
+#ifdef DARK_TOWER_LATENCY_PROBE
+
+// ------------------------------------------------
+// Latency probe
+// ------------------------------------------------
+
+// Built with DARK_TOWER_LATENCY_PROBE defined, the sketch times each button
+// press from when the button went down to when the frame buffer showing what
+// it did is sent to the LCD: the first frame sent after the press was taken
+// with nothing left to redraw, so a press that takes a few frames to settle
+// is timed to the last of them. Every LATENCY_REPORT_PRESSES presses it sends
+// a report in text over Serial of the 50th and 99th percentiles and the
+// longest, in milliseconds, of all the presses so far. The percentiles are
+// the tops of LATENCY_BUCKET_MS wide buckets. Presses on the title screen,
+// which is the library's own, are not timed. On the host, micros() is the
+// shim's clock, which moves on a frame at a time, so there the times count
+// the frames a press takes.
+
+#ifdef DARK_TOWER_RECORD_INPUT
+#error "DARK_TOWER_LATENCY_PROBE and DARK_TOWER_RECORD_INPUT both use Serial"
+#endif
+
+#define LATENCY_REPORT_PRESSES 100
+#define LATENCY_BUCKETS 64
+#define LATENCY_BUCKET_MS 2U
+#define LATENCY_MAX_PENDING 8
+
+class latency_probe_type {
+public:
+	latency_probe_type()
+	: presses( 0 )
+	, max_micros( 0 )
+	, pending_count( 0 )
+	, pending_settled( false )
+	{
+		memset(buckets, 0, sizeof(buckets));
+	}
+
+	// A press taken this frame, that went down millis_ago milliseconds ago.
+	void press_taken(uint16_t millis_ago){
+		if (pending_count < LATENCY_MAX_PENDING)
+			pending_starts[pending_count++] = micros() - millis_ago * 1000UL;
+		pending_settled = false;
+	}
+
+	void end_frame(boolean redraw_pending){
+		pending_settled = pending_count > 0 && !redraw_pending;
+	}
+
+	// Called on the first gb.update() after a frame, by which time it has
+	// been sent.
+	void frame_sent(){
+		if (!pending_settled)
+			return;
+
+		uint32_t now = micros();
+		for (uint8_t i = 0; i < pending_count; i++)
+			add(now - pending_starts[i]);
+		pending_count = 0;
+		pending_settled = false;
+	}
+
+	// Forgets the presses not yet timed.
+	void discard(){
+		pending_count = 0;
+		pending_settled = false;
+	}
+
+	void send_report(){
+		Serial.print(F("latency presses "));
+		Serial.println(presses);
+		Serial.print(F("latency p50 "));
+		Serial.println(get_percentile(50));
+		Serial.print(F("latency p99 "));
+		Serial.println(get_percentile(99));
+		Serial.print(F("latency max "));
+		Serial.println(get_max_millis());
+	}
+
+private:
+	uint16_t buckets[LATENCY_BUCKETS];
+	uint16_t presses;
+	uint32_t max_micros;
+	uint32_t pending_starts[LATENCY_MAX_PENDING];
+	uint8_t pending_count;
+	boolean pending_settled;
+
+	void add(uint32_t latency_micros){
+		// Each bucket takes the times up to and including its top.
+		uint32_t bucket = latency_micros > 0 ? (latency_micros - 1) / (LATENCY_BUCKET_MS * 1000UL) : 0;
+		buckets[bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1]++;
+		if (latency_micros > max_micros)
+			max_micros = latency_micros;
+		if (++presses % LATENCY_REPORT_PRESSES == 0)
+			send_report();
+	}
+
+	uint32_t get_max_millis(){
+		return (max_micros + 999) / 1000;
+	}
+
+	// The top of the bucket the percentile falls in, but no more than the
+	// longest time.
+	uint32_t get_percentile(uint8_t percent){
+		uint32_t wanted = ((uint32_t)presses * percent + 99) / 100;
+		uint32_t seen = 0;
+		for (uint8_t i = 0; i < LATENCY_BUCKETS - 1; i++){
+			seen += buckets[i];
+			uint32_t bucket_top = (i + 1) * LATENCY_BUCKET_MS;
+			if (seen >= wanted && seen > 0 && bucket_top < get_max_millis())
+				return bucket_top;
+		}
+		return get_max_millis();
+	}
+} latency_probe;
+
+#endif
+
+// ------------------------------------------------
+// Input
+// ------------------------------------------------
+
+// The buttons are sampled about every millisecond, from the timer 0 compare
+// interrupt, which leaves millis() on the overflow alone. A button counts as
+// changed once it has read the same for four samples in a row, and each
+// change goes into a ring buffer with the time it happened, so a press is
+// seen even when it is let go before the frame ends, and a long frame loses
+// none. The interrupt only ever moves the head of the buffer and the game
+// only the tail, and both are a byte, so neither has to stop the other. The
+// host's buttons are set a frame at a time and cannot bounce, so there they
+// are sampled as each frame starts.
+//
+// Once a frame, at its start, input_queue takes the changes into a queue of
+// events that the game then takes one at a time, so nothing sees a press
+// twice and the input is all handled before anything is drawn. An event is a
+// button that was pressed, or is repeating while held. Presses are queued in
+// the order they happened and repeats after them. Changes at the same time
+// are in the order below, so that the view scrolls before the menu takes its
+// buttons. A button with a repeat period of 0 does not repeat; the rest
+// repeat every that many milliseconds, the 4 and 5 frames they were at 20
+// frames a second.
+typedef uint8_t input_event;
+
+#define INPUT_EVENT_NONE 0xff
+#define INPUT_QUEUE_LENGTH 8
+// A power of two.
+#define INPUT_EDGE_BUFFER_SIZE 8
+#define INPUT_EDGE_PRESS 0x80
+
+const uint8_t input_buttons[NUM_BTN] PROGMEM =
+	{ BTN_DOWN
+	, BTN_UP
+	, BTN_RIGHT
+	, BTN_LEFT
+	, BTN_A
+	, BTN_B
+	, BTN_C
+	};
+
+// Indexed by button.
+const uint16_t input_repeat_periods[NUM_BTN] PROGMEM =
+	{ 250 // BTN_LEFT
+	, 200 // BTN_UP
+	, 250 // BTN_RIGHT
+	, 200 // BTN_DOWN
+	, 0 // BTN_A
+	, 0 // BTN_B
+	, 0 // BTN_C
+	};
+
+// Each edge is a button, with INPUT_EDGE_PRESS if it went down, and the low
+// 16 bits of millis() when it did.
+volatile uint8_t button_edges[INPUT_EDGE_BUFFER_SIZE];
+volatile uint16_t button_edge_times[INPUT_EDGE_BUFFER_SIZE];
+volatile uint8_t button_edge_head = 0;
+volatile uint8_t button_edge_tail = 0;
+
+// Adds an edge for each button in changed, in input_buttons order, and
+// returns the buttons it added. A change that does not fit is left for a
+// later sample to find again, so a press and its release are never split.
+uint8_t push_button_edges(uint8_t changed, uint8_t held, uint16_t time){
+	uint8_t pushed = 0;
+	for (uint8_t i = 0; i < NUM_BTN; i++){
+		uint8_t button = pgm_read_byte(&input_buttons[i]);
+		if (!(changed & (1 << button)))
+			continue;
+
+		uint8_t head = button_edge_head;
+		uint8_t next_head = (head + 1) & (INPUT_EDGE_BUFFER_SIZE - 1);
+		if (next_head == button_edge_tail)
+			break;
+		button_edges[head] = held & (1 << button) ? button | INPUT_EDGE_PRESS : button;
+		button_edge_times[head] = time;
+		button_edge_head = next_head;
+		pushed |= 1 << button;
+	}
+	return pushed;
+}
+
+#ifdef __AVR__
+
+volatile uint8_t *button_input_registers[NUM_BTN];
+uint8_t button_bit_masks[NUM_BTN];
+uint8_t debounced_buttons = 0;
+// Two-bit vertical counters, a bit of each for every button, counting down
+// the samples a button has read differently from debounced_buttons.
+uint8_t debounce_count_low = 0xff;
+uint8_t debounce_count_high = 0xff;
+
+ISR(TIMER0_COMPA_vect){
+	uint8_t held = 0;
+	for (uint8_t button = 0; button < NUM_BTN; button++)
+		if (!(*button_input_registers[button] & button_bit_masks[button]))
+			held |= 1 << button;
+
+	uint8_t changed = held ^ debounced_buttons;
+	debounce_count_low = ~(debounce_count_low & changed);
+	debounce_count_high = debounce_count_low ^ (debounce_count_high & changed);
+	changed &= debounce_count_low & debounce_count_high;
+	if (changed)
+		debounced_buttons ^= push_button_edges(changed, held, millis());
+}
+
+// The pins are the ones gb.begin() set up, read straight from their ports.
+void start_button_sampler(){
+	for (uint8_t button = 0; button < NUM_BTN; button++){
+		uint8_t pin = gb.buttons.pins[button];
+		button_input_registers[button] = portInputRegister(digitalPinToPort(pin));
+		button_bit_masks[button] = digitalPinToBitMask(pin);
+	}
+	OCR0A = 0x80;
+	TIMSK0 |= _BV(OCIE0A);
+}
+
+void poll_button_sampler(){
+}
+
+#else
+
+uint8_t sampled_buttons = 0;
+
+void start_button_sampler(){
+}
+
+void poll_button_sampler(){
+	uint8_t held = 0;
+	for (uint8_t button = 0; button < NUM_BTN; button++)
+		if (gb.buttons.timeHeld(button) > 0)
+			held |= 1 << button;
+
+	sampled_buttons ^= push_button_edges(held ^ sampled_buttons, held, millis());
+}
+
+#endif
+
+class input_queue_type {
+public:
+	input_queue_type()
+	: event_count( 0 )
+	, next_event( 0 )
+	, held_buttons( 0 )
+	, frame_buttons( 0 )
+	, idle( true )
+	{ }
+
+	void begin(){
+		start_button_sampler();
+	}
+
+	// Events not taken by the end of a frame are dropped here.
+	void sample(){
+		poll_button_sampler();
+		uint16_t now = millis();
+		uint8_t changed_buttons = 0;
+		uint8_t pressed_buttons = 0;
+		event_count = next_event = 0;
+
+		uint8_t tail = button_edge_tail;
+		while (tail != button_edge_head){
+			uint8_t button = button_edges[tail] & ~INPUT_EDGE_PRESS;
+			changed_buttons |= 1 << button;
+			if (button_edges[tail] & INPUT_EDGE_PRESS){
+				held_buttons |= 1 << button;
+				pressed_buttons |= 1 << button;
+				repeat_times[button] = button_edge_times[tail] + get_repeat_period(button);
+				add_event(button);
+#ifdef DARK_TOWER_LATENCY_PROBE
+				latency_probe.press_taken(now - button_edge_times[tail]);
+#endif
 			}
-			else if (object_selected == EVENT_OBJECT_STATUE)
-				return event(F("The curtain is too small to cover the statue."));
+			else
+				held_buttons &= ~(1 << button);
+			tail = (tail + 1) & (INPUT_EDGE_BUFFER_SIZE - 1);
+		}
+		button_edge_tail = tail;
+
+		for (uint8_t i = 0; i < NUM_BTN; i++){
+			uint8_t button = pgm_read_byte(&input_buttons[i]);
+			uint16_t period = get_repeat_period(button);
+			if (period == 0 || !(held_buttons & (1 << button)) || (int16_t)(now - repeat_times[button]) < 0)
+				continue;
+
+			add_event(button);
+			repeat_times[button] += period;
+			if ((int16_t)(now - repeat_times[button]) >= 0)
+				repeat_times[button] = now + period;
 		}
-		return event();
-	}
-};
 
-class f1_main_hall_event : public event {
-public:
-	f1_main_hall_event(){
-		description = (const char *)F("A red carpet leads between the entrance door and stairs that lead up and down. The oil lamps on the wall dimly light the room in dancing shadows.");
-		allow_actions = true;
-		internal_load_object_menu = static_cast<load_object_menu_type>(&real_load_object_menu);
-		internal_process_action_on_object = static_cast<process_action_on_object_type>(&real_process_action_on_object);
+		frame_buttons = pressed_buttons | held_buttons;
+		idle = (held_buttons | changed_buttons) == 0;
 	}
 
-private:
-	void real_load_object_menu(char *menu_buffer, uint8_t menu_length, uint8_t menu_item_length){
-		const __FlashStringHelper* object_list[] =
-			{ F("Entrance")
-			, F("Stairs up")
-			, F("Stairs down")
-			, F("Lamp")
-			};
-		uint8_t object_list_length = sizeof(object_list) / sizeof(typeof(object_list[0]));
-		copy_string_array_from_src_to_buf(object_list, object_list_length, menu_buffer, menu_length, menu_item_length);
-	}
-
-	event real_process_action_on_object(uint8_t selected_action, uint8_t object_selected){
-		// Switch statement approach uses fewer bytes than array lookup, but is more painful to maintain.
-		const __FlashStringHelper* look_descriptions[] =
-			{ F("The doors are made of old oak. Patterns of trees and falling leaves are carved into the doors.")
-			, F("The wooden stairs go up as they wind around the wall, leading to the next floor.")
-			, F("The stone stairs hug the wall as they descend into darkness.")
-			, F("The lamps are still running; though, they have not been touched for a long time.")
-			};
+	// The next event of the frame, or INPUT_EVENT_NONE once they are all taken.
+	input_event take(){
+		if (next_event == event_count)
+			return INPUT_EVENT_NONE;
+		return events[next_event++];
+	}
 
-		switch (selected_action){
-		case ACTION_ID_LOOK:
-			return event(look_descriptions[object_selected]);
-		case ACTION_ID_USE:
-			switch (object_selected){
-			case 0:
-				return event(F("The door is shut tight. You cannot open it."));
-			case 1:
-				return f2_main_hall_event();
-			case 2:
-				return f0_dark_room_event();
-			}
-			break;
-		case ACTION_ID_TAKE:
-			switch (object_selected){
-			case 3:
-				if ( !(player.has_item(PLAYER_ITEM_ID_OIL_LAMP)) ){
-					player.add_item(PLAYER_ITEM_ID_OIL_LAMP);
-					return event(F("You take one of the lamps off the wall."));
-				}
-				else
-					return event(F("You already have a lamp!"));
-			}
-			break;
-		}
-		return event();
+	void drop_rest(){
+		next_event = event_count;
 	}
-};
 
-event create_f0_main_hall_event(){
-	return f0_light_room_event();
-}
+	// No button is held, or was pressed or let go, this frame.
+	boolean is_idle(){
+		return idle;
+	}
 
-event create_f1_main_hall_event(){
-	return f1_main_hall_event();
-}
+	// The buttons pressed since the last frame or held now, bit n for
+	// button n.
+	uint8_t get_frame_buttons(){
+		return frame_buttons;
+	}
 
-event create_f2_main_hall_event(){
-	return f2_main_hall_event();
-}
+private:
+	input_event events[INPUT_QUEUE_LENGTH];
+	uint8_t event_count;
+	uint8_t next_event;
+	uint8_t held_buttons;
+	uint8_t frame_buttons;
+	uint16_t repeat_times[NUM_BTN];
+	boolean idle;
 
-event create_f3_main_hall_event(){
-	return f3_main_hall_event();
-}
+	uint16_t get_repeat_period(uint8_t button){
+		return pgm_read_word(&input_repeat_periods[button]);
+	}
 
-struct starting_event : public intro_event
-{};
+	void add_event(input_event button){
+		if (event_count < INPUT_QUEUE_LENGTH)
+			events[event_count++] = button;
+	}
+} input_queue;
 
 
 // ------------------------------------------------
 // Game Engine
 // ------------------------------------------------
 
-const char actionStringLook[] = "Look";
-const char actionStringTake[] = "Take";
-const char actionStringUse[] = "Use";
-const char actionStringOpen[] = "Item";
-const char actionStringContinue[] = "Continue";
-
-const char* const standard_actions[] =
-		{ actionStringLook
-		, actionStringTake
-		, actionStringUse
-		, actionStringOpen
+// Indexed by action_id.
+const text_id standard_actions[] PROGMEM =
+		{ TEXT_ACTION_LOOK
+		, TEXT_ACTION_TAKE
+		, TEXT_ACTION_USE
+		, TEXT_ACTION_ITEM
 		};
 
-const char* const continue_actions[] = { actionStringContinue };
+const text_id continue_actions[] PROGMEM = { TEXT_ACTION_CONTINUE };
 
 struct menu_event_handler;
 
@@ -1440,25 +2603,42 @@ struct menu_event_handler {
 	menu_cancel_handler handle_menu_cancel;
 };
 
+// Where a menu item goes: the pixel its name starts at, after the space
+// before it, its line, and its width with the space after it, in pixels.
+struct menu_item_layout_type
+{
+	uint8_t x;
+	uint8_t line;
+	uint8_t width;
+};
+
+#define ACTION_MENU_MAX_ITEMS OBJECT_MENU_LENGTH
+
+// The items are texts, printed straight from flash, from a list of handles in
+// RAM or in flash. They are laid out once, when a menu is loaded, so drawing
+// and moving the selection look only at the items on screen and never
+// measure a text.
 class action_menu_type {
 public:
 	action_menu_type()
 	: actions_allowed( false )
 	, selected_action( 0 )
-	, width_in_chars( 0 )
-	, scroll_delay( 5 )
 	, menu_items( 0 )
+	, menu_items_in_progmem( false )
 	, menu_items_count( 0 )
+	, menu_line_count( 1 )
 	, registered_menu_handler( NULL )
 	, min_line_for_selection( 0 )
 	, max_line_for_selection( UINT8_MAX )
 	{ }
 
-	void load_menu_from_string_list(const char* const * const string_menu_list, uint8_t menu_list_length){
-		menu_items = string_menu_list;
-		menu_items_count = menu_list_length;
-		width_in_chars = LCDWIDTH / gb.display.fontWidth;
-		selected_action = 0;
+	// The list must stay in place for as long as the menu is shown.
+	void load_menu_from_text_list(const text_id *text_menu_list, uint8_t menu_list_length){
+		load_menu(text_menu_list, false, menu_list_length);
+	}
+
+	void load_menu_from_progmem_text_list(const text_id *text_menu_list, uint8_t menu_list_length){
+		load_menu(text_menu_list, true, menu_list_length);
 	}
 
 	void register_menu_handler(menu_event_handler* handler){
@@ -1470,7 +2650,11 @@ public:
 	}
 
 	uint8_t get_display_line_count(){
-		return get_menu_line_count();
+		return menu_line_count;
+	}
+
+	uint8_t get_selected_item(){
+		return selected_action;
 	}
 
 	void set_min_max_line_for_selection(uint8_t min_line, uint8_t max_line){
@@ -1478,61 +2662,48 @@ public:
 		max_line_for_selection = max_line;
 	}
 
-	void process_controller_input(){
-		if ( should_move_right() )
+	// Moves the selection, or chooses or cancels, for a LEFT, RIGHT, A or B event.
+	void handle_input_event(input_event button){
+		switch (button){
+		case BTN_RIGHT:
 			select_next_item();
-		else if ( should_move_left() )
+			break;
+		case BTN_LEFT:
 			select_previous_item();
-
-		if (user_selected_action())
+			break;
+		case BTN_A:
 			raise_menu_selection_event();
-		else if (user_cancelled_menu())
+			break;
+		case BTN_B:
 			raise_menu_cancel_event();
+			break;
+		}
 	}
 
 private:
 	bool actions_allowed;
 	uint8_t selected_action;
-	uint8_t width_in_chars;
-	uint8_t scroll_delay;
-	const char* const * menu_items;
+	const text_id *menu_items;
+	bool menu_items_in_progmem;
 	uint8_t menu_items_count;
+	menu_item_layout_type menu_layout[ACTION_MENU_MAX_ITEMS];
+	uint8_t menu_line_count;
 	menu_event_handler *registered_menu_handler;
 	uint8_t min_line_for_selection;
 	uint8_t max_line_for_selection;
 
-	boolean user_selected_action(){
-		return ( gb.buttons.pressed(BTN_A) );
-	}
-
 	void raise_menu_selection_event(){
 		if ( registered_menu_handler != NULL )
 			if ( registered_menu_handler->handle_menu_selection != NULL )
 				CALL_REF((*registered_menu_handler), handle_menu_selection)( selected_action );
 	}
 
-	boolean user_cancelled_menu(){
-		return gb.buttons.pressed(BTN_B);
-	}
-
 	void raise_menu_cancel_event(){
 		if ( registered_menu_handler != NULL )
 			if ( registered_menu_handler->handle_menu_cancel != NULL )
 				CALL_REF((*registered_menu_handler), handle_menu_cancel)();
 	}
 
-	boolean should_move_right(){
-		boolean event_scroll_right = gb.buttons.repeat(BTN_RIGHT, scroll_delay);
-		event_scroll_right |= gb.buttons.pressed(BTN_RIGHT);
-		return event_scroll_right;
-	}
-
-	boolean should_move_left(){
-		boolean event_scroll_left = gb.buttons.repeat(BTN_LEFT, scroll_delay);
-		event_scroll_left |= gb.buttons.pressed(BTN_LEFT);
-		return event_scroll_left;
-	}
-
 	void select_next_item(){
 		if (selected_action + 1 < menu_items_count)
 			selected_action++;
@@ -1543,81 +2714,94 @@ private:
 			selected_action--;
 	}
 
-	const static char * const menuSpaceString = " ";
 	const static uint8_t select_boundary_buffer = 2;
 
-	void print_menu_item(const char *item){
-		if (gb.display.cursorX == 0){
-			gb.display.print( menuSpaceString );
-		}
-		else{
-			uint8_t cur_item_length = strlen(item) + 1;
-			uint8_t print_end_x = gb.display.cursorX + cur_item_length*gb.display.fontWidth;
-			if (print_end_x > LCDWIDTH){
-				gb.display.println();
-				gb.display.print( menuSpaceString );
+	void load_menu(const text_id *text_menu_list, bool in_progmem, uint8_t menu_list_length){
+		if (menu_list_length > ACTION_MENU_MAX_ITEMS)
+			menu_list_length = ACTION_MENU_MAX_ITEMS;
+		menu_items = text_menu_list;
+		menu_items_in_progmem = in_progmem;
+		menu_items_count = menu_list_length;
+		selected_action = 0;
+		lay_out_menu();
+	}
+
+	text_id get_menu_item(uint8_t item_index){
+		if (menu_items_in_progmem)
+			return pgm_read_word(&menu_items[item_index]);
+		return menu_items[item_index];
+	}
+
+	// Items follow each other along a line, each after a space, and one that
+	// does not fit starts the next line; the first item on a line always fits
+	// there.
+	void lay_out_menu(){
+		uint8_t space_width = char_width(' ');
+		uint8_t cur_width = space_width;
+		uint8_t cur_line = 0;
+
+		for (uint8_t i = 0; i < menu_items_count; i++){
+			menu_item_layout_type& item_layout = menu_layout[i];
+			item_layout.width = text_width( get_menu_item(i) ) + space_width;
+			if (cur_width > space_width && cur_width + item_layout.width > LCDWIDTH){
+				cur_width = space_width;
+				cur_line++;
 			}
+			item_layout.x = cur_width;
+			item_layout.line = cur_line;
+			cur_width += item_layout.width;
 		}
-		gb.display.print( item );
-		gb.display.print( menuSpaceString );
+		menu_line_count = cur_line + 1;
 	}
 
-	void print_selected_menu_item(const char *item){
-		uint8_t rect_width = ( strlen(item) + 1 ) * gb.display.fontWidth;
-		uint8_t go_back = rect_width + gb.display.fontWidth;
-		if (go_back > gb.display.cursorX)
-			go_back = gb.display.cursorX;
+	void print_menu_item(uint8_t item_index){
+		if (gb.display.cursorX == 0){
+			draw_char(' ');
+		}
+		else if (menu_layout[item_index].x == char_width(' ')){
+			gb.display.println();
+			draw_char(' ');
+		}
+		draw_text( get_menu_item(item_index) );
+		draw_char(' ');
+	}
 
-		uint8_t menu_item_x = gb.display.cursorX - go_back;
+	// The box runs from the middle of the space before the name to the middle
+	// of the space after it.
+	void print_selected_menu_item(uint8_t item_index){
+		uint8_t rect_width = menu_layout[item_index].width;
 		uint8_t menu_item_y = gb.display.cursorY;
 
-		uint8_t cur_screen_x_pos = menu_item_x + (gb.display.fontWidth/2);
+		uint8_t cur_screen_x_pos = menu_layout[item_index].x - char_width(' ') / 2;
 		uint8_t cur_screen_y_pos = menu_item_y - 2;
 		uint8_t rect_height = gb.display.fontHeight + 3;
 
 		gb.display.drawRoundRect(cur_screen_x_pos, cur_screen_y_pos, rect_width, rect_height, 3);
 	}
 
-	uint8_t first_item_print_skipping_lines(uint8_t lines_to_skip){
-		uint8_t cur_width = 1;
-		uint8_t line_count = 1;
+	uint8_t first_item_on_line(uint8_t line){
 		uint8_t i = 0;
-
-		if (lines_to_skip == 0)
-			return 0;
-
-		for (; i < menu_items_count; i++){
-			uint8_t cur_action_width = strlen( menu_items[i] ) + 1;
-			if (cur_width + cur_action_width <= width_in_chars)
-				cur_width += cur_action_width;
-			else{
-				cur_width = 1 + cur_action_width;
-				line_count++;
-				if (line_count > lines_to_skip)
-					break;
-			}
-		}
+		while (i < menu_items_count && menu_layout[i].line < line)
+			i++;
 		return i;
 	}
 
+	// Also prints the first item of the line after the last one to show, which
+	// the selection may not stay on.
 	void print_menu(uint8_t start_line, uint8_t lines_to_show){
+		PROFILE_SCOPE(PROFILE_SECTION_PRINT_MENU);
 		uint8_t line_count = 1;
-		uint8_t cur_y = gb.display.cursorY;
-		uint8_t i = first_item_print_skipping_lines(start_line);
+		uint8_t i = first_item_on_line(start_line);
 		uint8_t min_visible_line_for_selection = min_line_for_selection + (-start_line);
 		uint8_t max_visible_line_for_selection = max_line_for_selection + (-start_line);
 
 		for (; i < menu_items_count && line_count <= lines_to_show; i++){
-			print_menu_item( menu_items[i] );
-
-			if (gb.display.cursorY != cur_y){
-				line_count++;
-				cur_y = gb.display.cursorY;
-			}
+			print_menu_item( i );
+			line_count = menu_layout[i].line + (-start_line) + 1;
 
 			if (i == selected_action){
 				if (line_count >= min_visible_line_for_selection)
-					print_selected_menu_item( menu_items[i] );
+					print_selected_menu_item( i );
 				else
 					select_next_item();
 
@@ -1627,168 +2811,141 @@ private:
 		}
 	}
 
-	uint8_t get_menu_line_count(){
-		uint8_t cur_width = 1;
-		uint8_t line_count = 1;
+} action_menu;
 
-		for (uint8_t i = 0; i < menu_items_count; i++){
-			uint8_t cur_action_width = strlen( menu_items[i] ) + 1;
-			if (cur_width + cur_action_width <= width_in_chars)
-				cur_width += cur_action_width;
-			else{
-				cur_width = 1 + cur_action_width;
-				line_count++;
-			}
+
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+
+// Built with DARK_TOWER_SMOOTH_SCROLL defined, the screen scrolls a few
+// pixels a frame instead of a line at a time. The description box keeps up to
+// TEXT_STRIP_LINES of its lines already drawn, a byte row each, in a strip,
+// so showing the description is a copy of rows rather than drawing text. A
+// line is drawn into the strip when it comes into view, so a scroll of one
+// line still draws the text of that line. The whole description is not drawn
+// ahead: the longest run to 20 lines, more RAM than the device has to spare.
+// A frame is drawn where the scroll is heading, then moved back by what is
+// still left to scroll, with the line that comes into view taken from the
+// strip. The strip costs TEXT_STRIP_LINES * LCDWIDTH bytes of RAM, which is
+// why it is not built by default.
+#define TEXT_STRIP_LINES (LCDHEIGHT / 8 + 1)
+#define SMOOTH_SCROLL_STEP 2
+
+// Moves what is drawn in the frame buffer down by pixels, or up if it is
+// negative, by less than a byte row.
+void shift_frame(int8_t pixels){
+	uint8_t *column = gb.display.getBuffer();
+
+	for (uint8_t x = 0; x < LCDWIDTH; x++, column++){
+		if (pixels > 0){
+			for (uint8_t row = LCDHEIGHT / 8 - 1; row > 0; row--)
+				column[row * LCDWIDTH] = (column[row * LCDWIDTH] << pixels) | (column[(row - 1) * LCDWIDTH] >> (8 - pixels));
+			column[0] <<= pixels;
+		}
+		else {
+			for (uint8_t row = 0; row < LCDHEIGHT / 8 - 1; row++)
+				column[row * LCDWIDTH] = (column[row * LCDWIDTH] >> -pixels) | (column[(row + 1) * LCDWIDTH] << (8 + pixels));
+			column[(LCDHEIGHT / 8 - 1) * LCDWIDTH] >>= -pixels;
 		}
-		return line_count;
 	}
+}
 
-} action_menu;
-
+#endif
 
 class word_wrapped_text_box_type {
 public:
-	word_wrapped_text_box_type()
-	: event_description( {0} )
-	, event_description_line_count( 0 )
-	, description_size_limit( DESCRIPTION_SIZE )
-	, width_in_chars( 0 )
-	{ }
-
 	void load_event(event& new_event){
-		new_event.load_description(event_description, description_size_limit);
-		width_in_chars = LCDWIDTH / gb.display.fontWidth;
+		event_description.clear(LCDWIDTH);
+		new_event.load_description(event_description);
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+		strip_first_line = 0;
+		strip_line_count = 0;
+#endif
 	}
 
 	uint8_t get_display_line_count(){
-		return count_lines_in_description(event_description, width_in_chars);
+		return event_description.get_line_count();
 	}
 
 	void display_portion(uint8_t start_line, uint8_t lines_to_show){
-		const char *description_to_show = find_first_line_to_show_from_description( start_line );
-		print_string_to_screen_wrapped(description_to_show, lines_to_show, width_in_chars);
+		PROFILE_SCOPE(PROFILE_SECTION_DISPLAY_PORTION);
+		for (uint8_t line = start_line; line < event_description.get_line_count() && lines_to_show > 0; line++, lines_to_show--)
+			print_line_to_screen(line);
+	}
+
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+	// Has the strip hold the lines from first_line on, as many of line_count as
+	// there are. Only the lines it does not already hold are drawn, so a scroll
+	// of one line draws one. A line is drawn into the frame buffer's top row
+	// and copied from there, so this must come before the frame is drawn.
+	void prepare_lines(uint8_t first_line, uint8_t line_count){
+		uint8_t description_line_count = event_description.get_line_count();
+		if (first_line >= description_line_count)
+			return;
+		if (line_count > description_line_count - first_line)
+			line_count = description_line_count - first_line;
+		if (is_in_strip(first_line) && is_in_strip(first_line + line_count - 1))
+			return;
+
+		uint8_t *top_row = gb.display.getBuffer();
+		uint8_t new_line_count = description_line_count - first_line;
+		if (new_line_count > TEXT_STRIP_LINES)
+			new_line_count = TEXT_STRIP_LINES;
+		for (uint8_t line = first_line; line < first_line + new_line_count; line++){
+			if (is_in_strip(line))
+				continue;
+			memset(top_row, 0, LCDWIDTH);
+			gb.display.cursorX = gb.display.cursorY = 0;
+			event_description.draw_line(line);
+			memcpy(strip[line % TEXT_STRIP_LINES], top_row, LCDWIDTH);
+		}
+		strip_first_line = first_line;
+		strip_line_count = new_line_count;
+	}
+
+	// Copies a line from the strip into the frame buffer with its top at y,
+	// over what is there.
+	void draw_strip_line(uint8_t line, int8_t y){
+		if (!is_in_strip(line))
+			return;
+
+		const uint8_t *source = strip[line % TEXT_STRIP_LINES];
+		uint8_t *buffer = gb.display.getBuffer();
+		int8_t row = (y - (y & 7)) / 8;
+		uint8_t shift = y & 7;
+
+		for (uint8_t x = 0; x < LCDWIDTH; x++){
+			if (row >= 0 && row < LCDHEIGHT / 8)
+				buffer[row * LCDWIDTH + x] |= source[x] << shift;
+			if (shift > 0 && row + 1 >= 0 && row + 1 < LCDHEIGHT / 8)
+				buffer[(row + 1) * LCDWIDTH + x] |= source[x] >> (8 - shift);
+		}
 	}
+#endif
 
 private:
-	char event_description[DESCRIPTION_SIZE];
-	byte event_description_line_count;
-	uint8_t description_size_limit;
-	uint8_t width_in_chars;
-
-	const char* find_start_of_next_line(const char *string_to_search){
-		const char* cur_string_pos = find_next_word(string_to_search);
-		uint8_t cur_width = count_chars_to_print_on_one_line(cur_string_pos, width_in_chars);
+	description_type event_description;
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+	// A ring: line n is kept in strip[n % TEXT_STRIP_LINES].
+	uint8_t strip[TEXT_STRIP_LINES][LCDWIDTH];
+	uint8_t strip_first_line;
+	uint8_t strip_line_count;
 
-		return cur_string_pos + cur_width;
-	}
-
-	const char* find_first_line_to_show_from_description(uint8_t line_to_find){
-		const char* cur_string_pos = event_description;
-
-		for (uint8_t line_count = 0; line_count < line_to_find; line_count++)
-			cur_string_pos = find_start_of_next_line(cur_string_pos);
-
-		return cur_string_pos;
-	}
-
-	uint8_t get_word_length(const char* text_to_read){
-	  bool cont = true;
-	  const char* my_char = text_to_read;
-	  uint8_t length = 0;
-
-	  while (cont){
-	    switch (*my_char){
-	      case '\0':
-	      case ' ':
-	        cont = false;
-	        break;
-	      default:
-	        length++;
-	    }
-	    my_char++;
-	  }
-	  return length;
-	}
-
-	uint8_t count_chars_to_print_on_one_line(const char* string_to_count, uint8_t max_width_in_chars){
-	  bool cont = true;
-	  uint8_t cur_line_length = 0;
-	  const char *char_to_read_from = string_to_count;
-
-	  while (cont){
-	    uint8_t cur_word_length = get_word_length(char_to_read_from);
-
-	    if (cur_word_length == 0){
-	      if (*char_to_read_from == '\0')
-	        cont = false;
-	      else
-	        cur_word_length++;
-	    }
-
-	    if (cur_line_length + cur_word_length <= max_width_in_chars){
-	      cur_line_length += cur_word_length;
-	      char_to_read_from += cur_word_length;
-	    }
-	    else
-	      cont = false;
-	  }
-	  return cur_line_length;
+	boolean is_in_strip(uint8_t line){
+		return line >= strip_first_line && line < strip_first_line + strip_line_count;
 	}
 
-	const char* find_next_word(const char *string_to_search){
-	  const char *cur_char = string_to_search;
-	  bool cont = true;
-
-	  while (cont){
-	    if (*cur_char == '\0' || *cur_char != ' ')
-	      cont = false;
-	    else
-	      cur_char++;
-	  }
-	  return cur_char;
-	}
-
-	void print_string_to_screen_wrapped(const char* string_to_print, uint8_t max_lines, uint8_t max_width_in_chars){
-	  const char* cur_string_pos = string_to_print;
-	  bool cont = true;
-	  uint8_t line_count = 0;
-	  char line_to_print[max_width_in_chars + 2];
-
-	  while (cont){
-	    cur_string_pos = find_next_word(cur_string_pos);
-	    uint8_t cur_width = count_chars_to_print_on_one_line(cur_string_pos, max_width_in_chars);
-	    if (cur_width > 0){
-	      strncpy(line_to_print, cur_string_pos, cur_width);
-	      line_to_print[cur_width] = '\n';
-	      line_to_print[cur_width + 1] = '\0';
-	      gb.display.print(line_to_print);
-	      cur_string_pos += cur_width;
-	      line_count++;
-	    }
-	    else
-	      cont = false;
-	    if (line_count >= max_lines)
-	      cont = false;
-	  }
+	// Lines are a fixed height apart here, even one that fills its line.
+	void print_line_to_screen(uint8_t line){
+		draw_strip_line(line, gb.display.cursorY);
+		gb.display.cursorX = 0;
+		gb.display.cursorY += gb.display.fontHeight;
 	}
-
-	uint8_t count_lines_in_description(const char* string_to_read, uint8_t max_width_in_chars){
-	  const char* cur_string_pos = string_to_read;
-	  bool cont = true;
-	  uint8_t line_count = 0;
-
-	  while (cont){
-	    cur_string_pos = find_next_word(cur_string_pos);
-	    uint8_t cur_width = count_chars_to_print_on_one_line(cur_string_pos, max_width_in_chars);
-	    if (cur_width > 0){
-	      cur_string_pos += cur_width;
-	      line_count++;
-	    }
-	    else
-	      cont = false;
-	  }
-	  return line_count;
+#else
+	void print_line_to_screen(uint8_t line){
+		event_description.draw_line(line);
+		gb.display.write('\n');
 	}
+#endif
 
 } description_box;
 
@@ -1800,7 +2957,7 @@ public:
 	, top_line( 0 )
 	, screen_height( 0 )
 	, screen_width( 0 )
-	, scroll_delay( 4 )
+	, menu_lines_shown( 0 )
 	, event_scroll_up( false )
 	, event_scroll_down( false )
 	, menu_top_line( 0 )
@@ -1808,21 +2965,35 @@ public:
 	, select_line( 0 )
 	, select_line_limit( 0 )
 	, top_line_limit( 0 )
+	, redraw_needed( true )
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+	, drawn_top_line( 0 )
+	, scroll_offset( 0 )
+#endif
 	{}
 
+	// The frame buffer is kept between frames and only redrawn when something on screen may have changed.
+	void init(){
+		gb.display.persistence = true;
+		redraw_needed = true;
+	}
+
 	void load_event(event& new_event){
+		PROFILE_SCOPE(PROFILE_SECTION_LOAD_EVENT);
 		top_line = select_line = 0;
 		screen_height = LCDHEIGHT / gb.display.fontHeight;
 		screen_width = LCDWIDTH / gb.display.fontWidth;
 
 		description_box.load_event(new_event);
 		calculate_line_count();
+		redraw_needed = true;
 	}
 
 	void recalculate_line_count(){
 		calculate_line_count();
 		set_scroll_position(top_line);
 		check_and_correct_scroll();
+		redraw_needed = true;
 	}
 
 	uint8_t get_scroll_position(){
@@ -1832,18 +3003,40 @@ public:
 	void set_scroll_position(uint8_t new_position){
 		top_line = select_line = new_position;
 		check_and_correct_scroll();
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+		drawn_top_line = top_line;
+		scroll_offset = 0;
+#endif
 	}
 
 	void set_menu_title(const __FlashStringHelper* title){
 		menu_title = title;
 	}
 
+	// The last frame drawn is not yet what the screen will settle on.
+	boolean has_redraw_pending(){
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+		if (scroll_offset != 0)
+			return true;
+#endif
+		return redraw_needed;
+	}
+
+	// Nothing is left to draw until a button is pressed.
+	boolean is_settled(){
+		return !has_redraw_pending() && input_queue.is_idle();
+	}
+
 	void update_display(){
-		if (should_scroll_down())
-			scroll_down();
-		if (should_scroll_up())
-			scroll_up();
-		display_event();
+		PROFILE_SCOPE(PROFILE_SECTION_UPDATE_DISPLAY);
+		handle_input();
+
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+		if (scroll_offset != 0)
+			redraw_needed = true;
+#endif
+		if (redraw_needed || !input_queue.is_idle())
+			redraw_event();
 	}
 
 private:
@@ -1855,10 +3048,115 @@ private:
 	byte menu_top_line;
 	byte screen_height;
 	byte screen_width;
-	byte scroll_delay;
+	// The menu lines the last frame drawn had room for, which are the ones
+	// the player's buttons act on.
+	byte menu_lines_shown;
 	boolean event_scroll_up;
 	boolean event_scroll_down;
 	const __FlashStringHelper* menu_title;
+	boolean redraw_needed;
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+	byte drawn_top_line;
+	// Pixels the frame is still to scroll up, or down if negative.
+	int8_t scroll_offset;
+#endif
+
+	// Takes every event of the frame. The scroll buttons always scroll; the
+	// others go to the menu if the last frame showed it, and otherwise A or B
+	// jumps down to it. A choice from the menu changes what is on screen, so
+	// any events after it are dropped rather than taken against the new view.
+	void handle_input(){
+		event_scroll_down = event_scroll_up = false;
+
+		input_event button;
+		while ((button = input_queue.take()) != INPUT_EVENT_NONE){
+			switch (button){
+			case BTN_DOWN:
+				event_scroll_down = true;
+				scroll_down();
+				break;
+			case BTN_UP:
+				event_scroll_up = true;
+				scroll_up();
+				break;
+			case BTN_C:
+				game_state.state = GAME_STATE_ID_TITLE;
+				break;
+			default:
+				if (menu_lines_shown > 0){
+					action_menu.handle_input_event(button);
+					if (button == BTN_A || button == BTN_B)
+						input_queue.drop_rest();
+				}
+				else if ((button == BTN_A || button == BTN_B) && top_line + screen_height <= menu_top_line)
+					jump_to_menu();
+				break;
+			}
+		}
+	}
+
+	// Drawing can move the scroll position or the menu selection to keep them in view,
+	// so frames are redrawn until the view settles.
+	void redraw_event(){
+		uint8_t shown_top_line = top_line;
+		uint8_t shown_select_line = select_line;
+		uint8_t shown_menu_item = action_menu.get_selected_item();
+
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+		start_scroll_animation();
+#endif
+		redraw_needed = false;
+		gb.display.clear();
+		display_event();
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+		show_scroll_animation(shown_top_line);
+#endif
+
+		if (top_line != shown_top_line || select_line != shown_select_line || action_menu.get_selected_item() != shown_menu_item)
+			redraw_needed = true;
+	}
+
+#ifdef DARK_TOWER_SMOOTH_SCROLL
+	// A scroll of a line eases in from where the last frame showed; anything
+	// further is a jump.
+	void start_scroll_animation(){
+		int8_t lines_scrolled = top_line - drawn_top_line;
+		int8_t line_height = gb.display.fontHeight;
+
+		if (lines_scrolled == 1 || lines_scrolled == -1){
+			scroll_offset += lines_scrolled * line_height;
+			if (scroll_offset > line_height)
+				scroll_offset = line_height;
+			else if (scroll_offset < -line_height)
+				scroll_offset = -line_height;
+		}
+		else if (lines_scrolled != 0)
+			scroll_offset = 0;
+		drawn_top_line = top_line;
+
+		if (scroll_offset > 0)
+			description_box.prepare_lines(top_line - 1, screen_height + 1);
+		else
+			description_box.prepare_lines(top_line, screen_height + (scroll_offset < 0));
+	}
+
+	// Only description lines come into view from the strip; the others are
+	// mostly blank, and are left so until the scroll ends.
+	void show_scroll_animation(uint8_t shown_top_line){
+		if (scroll_offset == 0)
+			return;
+
+		shift_frame(scroll_offset);
+		if (scroll_offset > 0){
+			description_box.draw_strip_line(shown_top_line - 1, scroll_offset - gb.display.fontHeight);
+			scroll_offset = scroll_offset > SMOOTH_SCROLL_STEP ? scroll_offset - SMOOTH_SCROLL_STEP : 0;
+		}
+		else {
+			description_box.draw_strip_line(shown_top_line + screen_height, LCDHEIGHT + scroll_offset);
+			scroll_offset = scroll_offset < -SMOOTH_SCROLL_STEP ? scroll_offset + SMOOTH_SCROLL_STEP : 0;
+		}
+	}
+#endif
 
 	void check_and_correct_scroll(){
 		if (screen_height >= line_count)
@@ -1931,9 +3229,9 @@ private:
 
 		uint8_t remaining_lines = remaining_y_resolution / gb.display.fontHeight;
 
+		menu_lines_shown = remaining_lines;
 		if (remaining_lines > 0){
 			uint8_t start_on_line = 0;
-			action_menu.process_controller_input();
 			if (top_line > menu_top_line)
 				start_on_line = top_line + (-menu_top_line);
 
@@ -1954,11 +3252,6 @@ private:
 			display_adjust_for_menu_just_in_view( remaining_lines );
 			action_menu.display_portion( start_on_line, remaining_lines );
 		}
-		// Stupid hack due do doing too much in one frame - button presses would otherwise be detected for other things.
-		else
-			if (top_line + screen_height <= menu_top_line)
-				if (should_jump_to_menu())
-					jump_to_menu();
 	}
 
 	void display_adjust_for_menu_just_in_view(uint8_t remaining_lines){
@@ -1971,8 +3264,10 @@ private:
 	}
 
 	void display_menu_heading(){
-		if (gb.display.cursorY < LCDHEIGHT)
-			gb.display.println(menu_title);
+		if (gb.display.cursorY < LCDHEIGHT){
+			draw_progmem_chars((const char*)menu_title, strlen_P((const char*)menu_title));
+			gb.display.write('\n');
+		}
 	}
 
 	void display_spacer(){
@@ -1980,24 +3275,6 @@ private:
 			gb.display.println();
 	}
 
-	boolean should_scroll_down(){
-		event_scroll_down = gb.buttons.repeat(BTN_DOWN, scroll_delay);
-		event_scroll_down |= gb.buttons.pressed(BTN_DOWN);
-		return event_scroll_down;
-	}
-
-	boolean should_scroll_up(){
-		event_scroll_up = gb.buttons.repeat(BTN_UP, scroll_delay);
-		event_scroll_up |= gb.buttons.pressed(BTN_UP);
-		return event_scroll_up;
-	}
-
-	boolean should_jump_to_menu(){
-		boolean jump = gb.buttons.pressed(BTN_A);
-		jump |= gb.buttons.pressed(BTN_B);
-		return jump;
-	}
-
 	void jump_to_menu(){
 		if (top_line_limit < menu_top_line)
 			top_line = select_line = top_line_limit;
@@ -2024,9 +3301,13 @@ private:
 	}
 } game_screen;
 
+// The host solver's event_history_check_type walks the history below as
+// "Continue" does, deeper than content goes.
 class game_presenter_type : public menu_event_handler{
+	friend class event_history_check_type;
 public:
 	void init(){
+		game_screen.init();
 		load_first_event();
 		action_menu.register_menu_handler(this);
 		switch_to_event();
@@ -2039,40 +3320,52 @@ public:
 private:
 	event events[EVENT_MEMORY];
 	uint8_t event_stack_pos;
-	char object_menu_buf[OBJECT_MENU_LENGTH][OBJECT_MENU_ITEM_LENGTH];
-	char *object_menu[OBJECT_MENU_LENGTH];
+	event_handle_type history[EVENT_HISTORY_DEPTH];
+	uint8_t history_top;
+	uint8_t history_length;
+	text_id object_menu[OBJECT_MENU_LENGTH];
 	uint8_t object_menu_length;
 	action_id selected_action;
 	player_item_id selected_item;
 	uint8_t events_scroll_pos[EVENT_MEMORY];
 
+	// Carries on with the saved game, if there is one.
 	void load_first_event(){
 		event_stack_pos = 0;
+		history_length = 0;
+		clear_current_saved_screen_scroll_position();
 		game_screen.set_scroll_position(0);
-		starting_event first_event;
-		load_new_event( first_event );
+		event& first_event = get_current_event();
+#ifdef DARK_TOWER_RECORD_INPUT
+		build_event<starting_event>(first_event);
+#else
+		if (!save_game.load(SAVE_SLOT_PLAYER, first_event))
+			build_event<starting_event>(first_event);
+#endif
 	}
 
 	void switch_to_event(){
 		game_screen.load_event(get_current_event());
 		switch_to_action_menu();
 		game_screen.set_scroll_position(get_current_saved_screen_scroll_position());
+		if (get_current_event().get_room() != ROOM_ID_NONE)
+			save_game.save(SAVE_SLOT_PLAYER, get_current_event());
 	}
 
 	void switch_to_action_menu(){
 		if (get_current_event().actions_are_allowed()){
 			game_screen.set_menu_title(F("Select action"));
 			uint8_t menu_list_length = sizeof(standard_actions)/sizeof(typeof(standard_actions[0]));
-			action_menu.load_menu_from_string_list(standard_actions, menu_list_length);
-			handle_menu_selection = static_cast<menu_selection_handler>( &handle_action_menu_selection );
+			action_menu.load_menu_from_progmem_text_list(standard_actions, menu_list_length);
+			handle_menu_selection = static_cast<menu_selection_handler>( &game_presenter_type::handle_action_menu_selection );
 			handle_menu_cancel = NULL;
 		}
 		else {
 			game_screen.set_menu_title(NULL);
 			uint8_t menu_list_length = sizeof(continue_actions)/sizeof(typeof(continue_actions[0]));
-			action_menu.load_menu_from_string_list(continue_actions, menu_list_length);
-			handle_menu_selection = static_cast<menu_selection_handler>( &handle_action_menu_continue_selected );
-			handle_menu_cancel = static_cast<menu_cancel_handler>( &handle_action_menu_continue );
+			action_menu.load_menu_from_progmem_text_list(continue_actions, menu_list_length);
+			handle_menu_selection = static_cast<menu_selection_handler>( &game_presenter_type::handle_action_menu_continue_selected );
+			handle_menu_cancel = static_cast<menu_cancel_handler>( &game_presenter_type::handle_action_menu_continue );
 		}
 		game_screen.recalculate_line_count();
 	}
@@ -2089,15 +3382,43 @@ private:
 		return events_scroll_pos[event_stack_pos];
 	}
 
-	void load_new_event(event& new_event){
+	// The current event and the one before it are kept whole in events; the
+	// events before those are kept as handles in history, newest at
+	// history_top - 1, and the oldest are forgotten once it is full.
+	// history_length counts every event there is to go back to.
+
+	// Moves on to the next slot and returns it for the new event to be built in.
+	// The event before the current one leaves that slot for the history.
+	event& load_new_event(){
 		save_current_screen_scoll_position();
 		( ++event_stack_pos ) %= EVENT_MEMORY;
-		events[event_stack_pos] = new_event;
+
+		if (history_length > 0){
+			history[history_top] = events[event_stack_pos].get_handle(get_current_saved_screen_scroll_position());
+			( ++history_top ) %= EVENT_HISTORY_DEPTH;
+		}
+		if (history_length <= EVENT_HISTORY_DEPTH)
+			history_length++;
+
 		clear_current_saved_screen_scroll_position();
+		return events[event_stack_pos];
 	}
 
+	// Goes back to the event before, and rebuilds the one before that, if any,
+	// in the slot left free.
 	void load_previous_event(){
+		if (history_length == 0)
+			return;
+
+		uint8_t free_slot = event_stack_pos;
 		( --event_stack_pos ) %= EVENT_MEMORY;
+		history_length--;
+
+		if (history_length > 0){
+			history_top = (history_top + EVENT_HISTORY_DEPTH - 1) % EVENT_HISTORY_DEPTH;
+			build_event<event>(events[free_slot], history[history_top]);
+			events_scroll_pos[free_slot] = history[history_top].get_scroll_position();
+		}
 	}
 
 	event& get_current_event(){
@@ -2106,15 +3427,13 @@ private:
 
 	void handle_object_for_item_menu_selection(uint8_t selection){
 		event& current_event = get_current_event();
-		event next_event = current_event.process_item_on_object(selected_item, selection);
-		load_new_event(next_event);
+		current_event.process_item_on_object(selected_item, selection, load_new_event());
 		switch_to_event();
 	}
 
 	void handle_object_menu_selection(uint8_t selection){
 		event& current_event = get_current_event();
-		event next_event = current_event.process_action_on_object(selected_action, selection);
-		load_new_event(next_event);
+		current_event.process_action_on_object(selected_action, selection, load_new_event());
 		switch_to_event();
 	}
 
@@ -2135,13 +3454,13 @@ private:
 		if (get_current_event().should_return_to_previous_event())
 			load_previous_event();
 		else{
-			event next_event = get_current_event().get_continue_event();
-			load_new_event(next_event);
+			event& current_event = get_current_event();
+			current_event.get_continue_event(load_new_event());
 		}
 		switch_to_event();
 	}
 
-	void handle_action_menu_continue_selected(uint8_t ignored){
+	void handle_action_menu_continue_selected(uint8_t){
 		handle_action_menu_continue();
 	}
 
@@ -2152,89 +3471,412 @@ private:
 	void switch_to_object_for_item_menu(){
 		game_screen.set_menu_title(F("On what?"));
 		load_object_menu();
-		action_menu.load_menu_from_string_list(object_menu, object_menu_length);
+		action_menu.load_menu_from_text_list(object_menu, object_menu_length);
 		game_screen.recalculate_line_count();
-		handle_menu_selection = static_cast<menu_selection_handler>( &handle_object_for_item_menu_selection );
-		handle_menu_cancel = static_cast<menu_cancel_handler>( &handle_object_menu_cancel );
+		handle_menu_selection = static_cast<menu_selection_handler>( &game_presenter_type::handle_object_for_item_menu_selection );
+		handle_menu_cancel = static_cast<menu_cancel_handler>( &game_presenter_type::handle_object_menu_cancel );
 	}
 
 	void switch_to_object_menu(){
 		game_screen.set_menu_title(F("Which object?"));
 		load_object_menu();
-		action_menu.load_menu_from_string_list(object_menu, object_menu_length);
+		action_menu.load_menu_from_text_list(object_menu, object_menu_length);
 		game_screen.recalculate_line_count();
-		handle_menu_selection = static_cast<menu_selection_handler>( &handle_object_menu_selection );
-		handle_menu_cancel = static_cast<menu_cancel_handler>( &handle_object_menu_cancel );
+		handle_menu_selection = static_cast<menu_selection_handler>( &game_presenter_type::handle_object_menu_selection );
+		handle_menu_cancel = static_cast<menu_cancel_handler>( &game_presenter_type::handle_object_menu_cancel );
 	}
 
 	void switch_to_item_menu(){
-		clear_object_menu();
-		uint8_t menu_length = player.load_item_menu(&object_menu_buf[0][0], OBJECT_MENU_LENGTH, OBJECT_MENU_ITEM_LENGTH);
-		build_object_menu_refs();
-		if (menu_length > 0){
+		object_menu_length = player.load_item_menu(object_menu, OBJECT_MENU_LENGTH);
+		if (object_menu_length > 0){
 			game_screen.set_menu_title(F("Use what?"));
-			action_menu.load_menu_from_string_list(object_menu, menu_length);
+			action_menu.load_menu_from_text_list(object_menu, object_menu_length);
 			game_screen.recalculate_line_count();
-			handle_menu_selection = static_cast<menu_selection_handler>( &handle_item_menu_selection );
-			handle_menu_cancel = static_cast<menu_cancel_handler>( &handle_object_menu_cancel );
+			handle_menu_selection = static_cast<menu_selection_handler>( &game_presenter_type::handle_item_menu_selection );
+			handle_menu_cancel = static_cast<menu_cancel_handler>( &game_presenter_type::handle_object_menu_cancel );
 		}
 		else{
-			event empty_item_menu(F("You are carrying no useful items!"));
-			load_new_event(empty_item_menu);
+			build_event<event>(load_new_event(), TEXT_NO_USEFUL_ITEMS);
 			switch_to_event();
 		}
 	}
 
-	void clear_object_menu(){
-		memset(object_menu_buf, 0, sizeof(object_menu_buf));
+	void load_object_menu(){
+		object_menu_length = get_current_event().load_object_menu(object_menu, OBJECT_MENU_LENGTH);
 	}
+} game_presenter;
 
-	void load_object_menu_buf(){
-		clear_object_menu();
-		event& current_event = get_current_event();
-		current_event.load_object_menu(&object_menu_buf[0][0], OBJECT_MENU_LENGTH, OBJECT_MENU_ITEM_LENGTH);
+// ------------------------------------------------
+// Frame rate
+// ------------------------------------------------
+
+// The screen is left alone while the player reads, so once it has settled
+// and no button has been touched for GOVERNOR_IDLE_FRAMES, the game drops to
+// GOVERNOR_IDLE_FRAME_RATE, and after GOVERNOR_DIM_FRAMES more it dims the
+// backlight too. Any button brings back the full frame rate and the automatic
+// backlight as soon as the sampler sees it. Between frames the AVR sleeps
+// until the next interrupt, rather than spinning in gb.update(). Frames are
+// counted, not timed, so a recording replays the same however fast its frames
+// ran.
+#define GOVERNOR_FRAME_RATE NUM_FRAMES_PER_SECOND
+#define GOVERNOR_IDLE_FRAME_RATE 5
+#define GOVERNOR_IDLE_FRAMES (2 * GOVERNOR_FRAME_RATE)
+#define GOVERNOR_DIM_FRAMES (30 * GOVERNOR_IDLE_FRAME_RATE)
+#define GOVERNOR_DIM_BACKLIGHT 16
+
+#ifdef __AVR__
+
+#include <avr/sleep.h>
+
+// Idle sleep stops only the CPU, so the millis() timer wakes it within a
+// millisecond, and the display and sound carry on.
+void sleep_until_interrupt(){
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	sleep_mode();
+}
+
+#else
+
+void sleep_until_interrupt(){
+}
+
+#endif
+
+class frame_governor_type {
+public:
+	frame_governor_type()
+	: idle_frames( 0 )
+	, idle( false )
+	, dimmed( false )
+	{ }
+
+	// Called once a frame, after the game has run, with whether there is
+	// anything still to draw.
+	void end_frame(boolean settled){
+		if (!settled){
+			if (idle)
+				wake();
+			idle_frames = 0;
+			return;
+		}
+
+		if (idle_frames < 0xffff)
+			idle_frames++;
+		if (!idle && idle_frames >= GOVERNOR_IDLE_FRAMES){
+			idle = true;
+			idle_frames = 0;
+			gb.setFrameRate(GOVERNOR_IDLE_FRAME_RATE);
+		}
+		else if (idle && !dimmed && idle_frames >= GOVERNOR_DIM_FRAMES){
+			dimmed = true;
+			gb.backlight.automatic = false;
+			gb.backlight.set(GOVERNOR_DIM_BACKLIGHT);
+		}
 	}
 
-	void load_object_menu(){
-		load_object_menu_buf();
-		build_object_menu_refs();
+	// Called between frames when the button sampler has queued an edge. A
+	// shorter frame period makes the next gb.update() start a frame at once, so
+	// a press while idle waits one sampler tick rather than one idle frame.
+	void input_pending(){
+		idle_frames = 0;
+		if (idle)
+			wake();
 	}
 
-	void build_object_menu_refs(){
-		uint8_t i=0;
-		for(; i<OBJECT_MENU_LENGTH; i++){
-			if (object_menu_buf[i][0] != '\0')
-				object_menu[i] = &object_menu_buf[i][0];
-			else
-				break;
+private:
+	uint16_t idle_frames;
+	boolean idle;
+	boolean dimmed;
+
+	void wake(){
+		idle = false;
+		gb.setFrameRate(GOVERNOR_FRAME_RATE);
+		if (dimmed){
+			dimmed = false;
+			gb.backlight.automatic = true;
 		}
-		object_menu_length = i;
 	}
-} game_presenter;
+} frame_governor;
+
+#ifdef DARK_TOWER_RECORD_INPUT
+
+// ------------------------------------------------
+// Input recording
+// ------------------------------------------------
+
+// Built with DARK_TOWER_RECORD_INPUT defined, the sketch sends the buttons
+// held in each frame over Serial, for the host build to replay (see
+// host/src/replay.cpp). A recording is INPUT_RECORDING_MAGIC, then a record
+// each time the buttons held change: the frames since the last record, as a
+// little-endian uint16_t, then the buttons now held, with bit n for button n.
+// A button pressed and let go between two frames is recorded as held for the
+// frame that saw it, so a replay still presses it. Longer gaps are split by
+// records that repeat the same buttons. Frames are counted from the first one
+// after setup(), and a recording build always starts a new game, so that a
+// replay starts from the same place.
+#define INPUT_RECORDING_MAGIC "DTR1"
+
+class input_recorder_type {
+public:
+	input_recorder_type()
+	: frames_since_record( 0 )
+	, last_buttons( 0 )
+	{ }
+
+	void begin(){
+		Serial.write(INPUT_RECORDING_MAGIC);
+	}
+
+	void record_frame(){
+		uint8_t buttons = input_queue.get_frame_buttons();
+		if (buttons != last_buttons || frames_since_record == 0xffff){
+			Serial.write(frames_since_record & 0xff);
+			Serial.write(frames_since_record >> 8);
+			Serial.write(buttons);
+			frames_since_record = 0;
+			last_buttons = buttons;
+		}
+		frames_since_record++;
+	}
+
+private:
+	uint16_t frames_since_record;
+	uint8_t last_buttons;
+} input_recorder;
+
+#endif
+
+#ifdef DARK_TOWER_MEMORY_REPORT
+
+// ------------------------------------------------
+// Memory report
+// ------------------------------------------------
+
+// Built with DARK_TOWER_MEMORY_REPORT defined, the sketch paints its free RAM
+// with MEMORY_CANARY at boot, and sends a report of its memory over Serial
+// whenever it receives MEMORY_REPORT_REQUEST. The report gives the sizes of
+// the static data, the bss and the largest globals, and how deep the stack
+// has ever gone: the painted bytes the stack has never reached are the
+// headroom left. The host build gives the same report with the host's sizes,
+// taking the data and bss from the linker's symbols and measuring a stack the
+// shim paints, less the size of the RAM, which it does not have.
+
+#ifdef DARK_TOWER_RECORD_INPUT
+#error "DARK_TOWER_MEMORY_REPORT and DARK_TOWER_RECORD_INPUT both use Serial"
+#endif
+
+#define MEMORY_CANARY 0xc5
+#define MEMORY_REPORT_REQUEST 'm'
+#define MEMORY_GLOBAL_NAME_LENGTH 16
+
+#ifdef __AVR__
+
+extern uint8_t __data_start;
+extern uint8_t __data_end;
+extern uint8_t __bss_start;
+extern uint8_t __bss_end;
+extern uint8_t __heap_start;
+extern void *__brkval;
+
+// Runs before the globals are set up. It is written in assembly, using only
+// the registers it names, so that it cannot touch the stack it paints
+// whatever the optimisation.
+void paint_memory() __attribute__((naked, used, section(".init3")));
+void paint_memory(){
+	__asm__ volatile (
+		"	ldi r30, lo8(__heap_start)\n"
+		"	ldi r31, hi8(__heap_start)\n"
+		"	ldi r24, %0\n"
+		"	ldi r25, hi8(__stack)\n"
+		"	rjmp 2f\n"
+		"1:	st Z+, r24\n"
+		"2:	cpi r30, lo8(__stack)\n"
+		"	cpc r31, r25\n"
+		"	brlo 1b\n"
+		"	breq 1b\n"
+		:
+		: "i" (MEMORY_CANARY)
+		: "r24", "r25", "r30", "r31", "memory"
+		);
+}
+
+uint16_t get_data_size(){
+	return &__data_end - &__data_start;
+}
+
+uint16_t get_bss_size(){
+	return &__bss_end - &__bss_start;
+}
+
+uint16_t get_heap_size(){
+	return __brkval != NULL ? (const uint8_t*)__brkval - &__heap_start : 0;
+}
+
+// The painted bytes above the heap that are still untouched.
+uint16_t get_stack_headroom(){
+	const uint8_t *cell = __brkval != NULL ? (const uint8_t*)__brkval : &__heap_start;
+	uint16_t headroom = 0;
+	for (; cell <= (const uint8_t*)RAMEND && *cell == MEMORY_CANARY; cell++)
+		headroom++;
+	return headroom;
+}
+
+uint16_t get_stack_used(){
+	const uint8_t *heap_end = __brkval != NULL ? (const uint8_t*)__brkval : &__heap_start;
+	return (const uint8_t*)RAMEND + 1 - heap_end - get_stack_headroom();
+}
+
+#else
+
+#include <gamebuino_host.h>
+
+uint32_t get_data_size(){
+	return host_get_data_size();
+}
+
+uint32_t get_bss_size(){
+	return host_get_bss_size();
+}
+
+uint32_t get_heap_size(){
+	return host_get_heap_size();
+}
+
+uint32_t get_stack_headroom(){
+	return host_get_stack_headroom();
+}
+
+uint32_t get_stack_used(){
+	return host_get_stack_used();
+}
+
+#endif
+
+struct memory_global_type
+{
+	char name[MEMORY_GLOBAL_NAME_LENGTH];
+	uint16_t size;
+};
+
+#define MEMORY_GLOBAL(global) { #global, sizeof(global) }
+
+const memory_global_type memory_globals[] PROGMEM =
+	{ MEMORY_GLOBAL(gb)
+	, MEMORY_GLOBAL(Serial)
+	, MEMORY_GLOBAL(player)
+	, MEMORY_GLOBAL(room_state)
+	, MEMORY_GLOBAL(game_state)
+	, MEMORY_GLOBAL(save_game)
+	, MEMORY_GLOBAL(action_menu)
+	, MEMORY_GLOBAL(description_box)
+	, MEMORY_GLOBAL(game_screen)
+	, MEMORY_GLOBAL(game_presenter)
+#ifdef DARK_TOWER_PROFILE
+	, MEMORY_GLOBAL(profiler)
+#endif
+	};
+
+class memory_report_type {
+public:
+	void poll(){
+		while (Serial.available() > 0){
+			if (Serial.read() == MEMORY_REPORT_REQUEST)
+				send_report();
+		}
+	}
+
+private:
+	void print_size(const __FlashStringHelper *name, unsigned long size){
+		Serial.print(name);
+		Serial.println(size);
+	}
+
+	void send_report(){
+#ifdef __AVR__
+		print_size(F("ram "), RAMEND + 1 - RAMSTART);
+#endif
+		print_size(F("data "), get_data_size());
+		print_size(F("bss "), get_bss_size());
+		print_size(F("heap "), get_heap_size());
+		print_size(F("stack used "), get_stack_used());
+		print_size(F("stack headroom "), get_stack_headroom());
+		for (uint8_t i = 0; i < sizeof(memory_globals) / sizeof(memory_globals[0]); i++){
+			Serial.print(F("global "));
+			Serial.print(reinterpret_cast<const __FlashStringHelper *>(memory_globals[i].name));
+			print_size(F(" "), pgm_read_word(&memory_globals[i].size));
+		}
+		Serial.println(F("end"));
+	}
+} memory_report;
+
+#endif
 
 void setup() {
   gb.begin();
+  gb.display.setFont(TEXT_FONT);
+  input_queue.begin();
   Serial.begin(115200);
+#ifdef DARK_TOWER_RECORD_INPUT
+  input_recorder.begin();
+#endif
+#ifdef DARK_TOWER_PROFILE
+  profiler.begin();
+#endif
 }
 
 void loop() {
 	if (gb.update()){
+#ifdef DARK_TOWER_LATENCY_PROBE
+		latency_probe.frame_sent();
+#endif
+		input_queue.sample();
+#ifdef DARK_TOWER_RECORD_INPUT
+		input_recorder.record_frame();
+#endif
+#ifdef DARK_TOWER_MEMORY_REPORT
+		memory_report.poll();
+#endif
+#ifdef DARK_TOWER_PROFILE
+		profiler.start_frame();
+#endif
 		switch (game_state.state){
 		case GAME_STATE_ID_INIT:
 			game_presenter.init();
 			game_state.state = GAME_STATE_ID_PLAY;
+			frame_governor.end_frame(false);
+#ifdef DARK_TOWER_LATENCY_PROBE
+			latency_probe.discard();
+#endif
 			break;
 		case GAME_STATE_ID_PLAY:
 			game_presenter.update();
-			if (gb.buttons.pressed(BTN_C))
-				game_state.state = GAME_STATE_ID_TITLE;
+#ifdef DARK_TOWER_PROFILE
+			profiler.end_frame();
+#endif
+			frame_governor.end_frame(game_screen.is_settled());
+#ifdef DARK_TOWER_LATENCY_PROBE
+			latency_probe.end_frame(game_screen.has_redraw_pending());
+#endif
 			break;
 		case GAME_STATE_ID_TITLE:
 			gb.display.setFont(font3x5);
 		    gb.titleScreen(F("The Dark Tower"));
 		    game_state.state = GAME_STATE_ID_INIT;
-			gb.display.setFont(font5x7);
+			gb.display.setFont(TEXT_FONT);
+			frame_governor.end_frame(false);
+#ifdef DARK_TOWER_LATENCY_PROBE
+			latency_probe.discard();
+#endif
 			break;
 		}
 	}
+	else{
+#ifdef DARK_TOWER_LATENCY_PROBE
+		latency_probe.frame_sent();
+#endif
+		if (button_edge_head != button_edge_tail)
+			frame_governor.input_pending();
+		else
+			sleep_until_interrupt();
+	}
 }
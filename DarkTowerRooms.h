@@ -0,0 +1,163 @@
+/*
+ * Dark Tower
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Generated from DarkTowerRooms.txt by tools/compile_rooms.py. Do not edit.
+
+#ifndef DARK_TOWER_ROOMS_H
+#define DARK_TOWER_ROOMS_H
+
+typedef uint8_t room_id;
+
+#define ROOM_ID_NONE 0xff
+#define ROOM_ID_F1_MAIN_HALL 0
+#define ROOM_ID_F2_MAIN_HALL 1
+#define ROOM_ID_F3_MAIN_HALL 2
+#define ROOM_ID_F4_MAIN_HALL_LOCKED 3
+#define ROOM_ID_F4_MAIN_HALL 4
+#define ROOM_ID_F4_OPEN_CHEST_WITH_CHEST_KEY 5
+#define ROOM_ID_F4_OPEN_CHEST_WITH_MODIFIED_KEY 6
+#define ROOM_ID_F4_OPEN_CHEST_WITH_COPIED_KEY 7
+#define ROOM_ID_F0_DARK_ROOM 8
+#define ROOM_ID_F0_LIGHT_ROOM 9
+#define ROOM_ID_F0_MONSTER_ATTACKS 10
+#define ROOM_ID_F0_IN_THE_WELL 11
+#define ROOM_COUNT 12
+
+#define ROOM_MAX_OBJECTS 10
+
+#define ROOM_FLAG_F2_MAIN_HALL_NOTICE_SWORD 0
+#define ROOM_FLAG_F2_MAIN_HALL_NOTICE_KEY 1
+#define ROOM_FLAG_F3_MAIN_HALL_NOTICE_KEY 2
+#define ROOM_FLAG_F0_LIGHT_ROOM_NOTICE_ROPE 3
+#define ROOM_FLAG_F0_IN_THE_WELL_NOTICE_KEY 4
+#define ROOM_FLAG_COUNT 5
+
+struct room_type
+{
+	text_id description;
+	uint16_t first_object;
+	uint8_t object_count;
+};
+
+// A missing text is TEXT_NONE, and an object that leads nowhere has ROOM_ID_NONE.
+struct room_object_type
+{
+	text_id name;
+	text_id look;
+	text_id use;
+	text_id take;
+	room_id exit;
+};
+
+const room_type rooms[ROOM_COUNT] PROGMEM =
+	{ { TEXT_F1_HALL_DESCRIPTION, 0, 4 } // f1_main_hall
+	, { TEXT_F2_HALL_DESCRIPTION, 4, 6 } // f2_main_hall
+	, { TEXT_F3_HALL_DESCRIPTION, 10, 5 } // f3_main_hall
+	, { TEXT_F4_LOCKED_DESCRIPTION, 15, 2 } // f4_main_hall_locked
+	, { TEXT_F4_HALL_DESCRIPTION, 17, 2 } // f4_main_hall
+	, { TEXT_F4_CHEST_DESCRIPTION, 19, 2 } // f4_open_chest_with_chest_key
+	, { TEXT_F4_CHEST_DESCRIPTION, 21, 2 } // f4_open_chest_with_modified_key
+	, { TEXT_F4_CHEST_DESCRIPTION, 23, 3 } // f4_open_chest_with_copied_key
+	, { TEXT_F0_DARK_DESCRIPTION, 26, 2 } // f0_dark_room
+	, { TEXT_F0_STORE_DESCRIPTION, 28, 4 } // f0_light_room
+	, { TEXT_F0_STORE_DESCRIPTION, 32, 4 } // f0_monster_attacks
+	, { TEXT_F0_WELL_DESCRIPTION, 36, 4 } // f0_in_the_well
+	};
+
+const room_object_type room_objects[] PROGMEM =
+	// f1_main_hall
+	{ { TEXT_OBJECT_ENTRANCE, TEXT_F1_HALL_LOOK_ENTRANCE, TEXT_DOOR_SHUT_TIGHT, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_STAIRS_UP, TEXT_F1_HALL_LOOK_STAIRS_UP, TEXT_NONE, TEXT_NONE, ROOM_ID_F2_MAIN_HALL }
+	, { TEXT_OBJECT_STAIRS_DOWN, TEXT_F1_HALL_LOOK_STAIRS_DOWN, TEXT_NONE, TEXT_NONE, ROOM_ID_F0_DARK_ROOM }
+	, { TEXT_OBJECT_LAMP, TEXT_F1_HALL_LOOK_LAMP, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	// f2_main_hall
+	, { TEXT_OBJECT_WINDOW, TEXT_F2_HALL_LOOK_WINDOW, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_ANGEL_STATUE, TEXT_F2_HALL_LOOK_STATUE, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_STAIRS_UP, TEXT_F2_HALL_LOOK_STAIRS_UP, TEXT_NONE, TEXT_NONE, ROOM_ID_F3_MAIN_HALL }
+	, { TEXT_OBJECT_STAIRS_DOWN, TEXT_F2_HALL_LOOK_STAIRS_DOWN, TEXT_NONE, TEXT_NONE, ROOM_ID_F1_MAIN_HALL }
+	, { TEXT_OBJECT_SILVER_SWORD, TEXT_F2_HALL_LOOK_SWORD, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_KEY, TEXT_F2_HALL_LOOK_SWORD_ON_FLOOR, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	// f3_main_hall
+	, { TEXT_OBJECT_TABLE, TEXT_F3_HALL_LOOK_TABLE_WITH_KEY, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_CURTAIN, TEXT_F3_HALL_LOOK_CURTAIN, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_STAIRS_UP, TEXT_F3_HALL_LOOK_STAIRS_UP, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_STAIRS_DOWN, TEXT_F3_HALL_LOOK_STAIRS_DOWN, TEXT_NONE, TEXT_NONE, ROOM_ID_F2_MAIN_HALL }
+	, { TEXT_OBJECT_KEY, TEXT_F3_HALL_LOOK_KEY, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	// f4_main_hall_locked
+	, { TEXT_F4_LOCKED_OBJECT_STAIRS_DOWN, TEXT_F4_LOCKED_LOOK_STAIRS_DOWN, TEXT_NONE, TEXT_NONE, ROOM_ID_F3_MAIN_HALL }
+	, { TEXT_OBJECT_DOOR, TEXT_F4_LOCKED_LOOK_DOOR, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	// f4_main_hall
+	, { TEXT_OBJECT_CHEST, TEXT_F4_HALL_LOOK_CHEST, TEXT_NONE, TEXT_F4_HALL_TAKE_CHEST, ROOM_ID_NONE }
+	, { TEXT_OBJECT_STAIRS_DOWN, TEXT_F4_HALL_LOOK_STAIRS_DOWN, TEXT_NONE, TEXT_NONE, ROOM_ID_F3_MAIN_HALL }
+	// f4_open_chest_with_chest_key
+	, { TEXT_OBJECT_VIAL, TEXT_F4_CHEST_LOOK_PINK_VIAL, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_DOOR, TEXT_DOOR_SHUT_TIGHT, TEXT_DOOR_SHUT_TIGHT, TEXT_DOOR_SHUT_TIGHT, ROOM_ID_NONE }
+	// f4_open_chest_with_modified_key
+	, { TEXT_OBJECT_PINK_VIAL, TEXT_F4_CHEST_LOOK_PINK_VIAL, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_DOOR, TEXT_DOOR_SHUT_TIGHT, TEXT_DOOR_SHUT_TIGHT, TEXT_DOOR_SHUT_TIGHT, ROOM_ID_NONE }
+	// f4_open_chest_with_copied_key
+	, { TEXT_OBJECT_PINK_VIAL, TEXT_F4_CHEST_LOOK_PINK_VIAL, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_YELLOW_VIAL, TEXT_F4_CHEST_LOOK_YELLOW_VIAL, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_DOOR, TEXT_DOOR_SHUT_TIGHT, TEXT_DOOR_SHUT_TIGHT, TEXT_DOOR_SHUT_TIGHT, ROOM_ID_NONE }
+	// f0_dark_room
+	, { TEXT_OBJECT_STAIRS_UP, TEXT_F0_LOOK_STAIRS_UP, TEXT_NONE, TEXT_NONE, ROOM_ID_F1_MAIN_HALL }
+	, { TEXT_OBJECT_DARKNESS, TEXT_F0_DARK_LOOK_DARKNESS, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	// f0_light_room
+	, { TEXT_OBJECT_STAIRS_UP, TEXT_F0_LOOK_STAIRS_UP, TEXT_NONE, TEXT_NONE, ROOM_ID_F1_MAIN_HALL }
+	, { TEXT_OBJECT_BARRELS, TEXT_F0_STORE_LOOK_BARRELS, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_WELL, TEXT_F0_STORE_LOOK_WELL, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_ROPE, TEXT_F0_STORE_LOOK_ROPE, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	// f0_monster_attacks
+	, { TEXT_OBJECT_STAIRS_UP, TEXT_NONE, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_BARRELS, TEXT_NONE, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_WELL, TEXT_NONE, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_LARGE_BAT, TEXT_F0_BAT_LOOK_BAT, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	// f0_in_the_well
+	, { TEXT_OBJECT_WATER, TEXT_F0_WELL_LOOK_WATER, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_ROPE, TEXT_F0_WELL_LOOK_ROPE, TEXT_NONE, TEXT_NONE, ROOM_ID_F0_LIGHT_ROOM }
+	, { TEXT_OBJECT_CRYSTAL, TEXT_F0_WELL_LOOK_CRYSTAL, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	, { TEXT_OBJECT_KEY, TEXT_F0_WELL_LOOK_KEY, TEXT_NONE, TEXT_NONE, ROOM_ID_NONE }
+	};
+
+#ifdef DARK_TOWER_ROOM_NAMES
+// Room and flag names, for tools built on the host.
+const char *const room_names[ROOM_COUNT] =
+	{ "f1_main_hall"
+	, "f2_main_hall"
+	, "f3_main_hall"
+	, "f4_main_hall_locked"
+	, "f4_main_hall"
+	, "f4_open_chest_with_chest_key"
+	, "f4_open_chest_with_modified_key"
+	, "f4_open_chest_with_copied_key"
+	, "f0_dark_room"
+	, "f0_light_room"
+	, "f0_monster_attacks"
+	, "f0_in_the_well"
+	};
+
+const char *const room_flag_names[ROOM_FLAG_COUNT] =
+	{ "f2_main_hall.notice_sword"
+	, "f2_main_hall.notice_key"
+	, "f3_main_hall.notice_key"
+	, "f0_light_room.notice_rope"
+	, "f0_in_the_well.notice_key"
+	};
+#endif
+
+#endif
@@ -0,0 +1,751 @@
+/*
+ * Dark Tower
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Generated from DarkTowerText.txt by tools/compress_text.py. Do not edit.
+
+#ifndef DARK_TOWER_TEXT_H
+#define DARK_TOWER_TEXT_H
+
+// A handle to a compressed text: its offset in text_streams.
+typedef uint16_t text_id;
+
+#define TEXT_NONE ((text_id)0xffff)
+
+#define TEXT_CODE_END 0x00
+#define TEXT_CODE_LITERAL_MAX 0x3f
+#define TEXT_CODE_EMPTY_WORD 0x40
+#define TEXT_CODE_WORD 0x41
+#define TEXT_CODE_LONG_WORD 0xf0
+#define TEXT_SHORT_WORD_CODES (TEXT_CODE_LONG_WORD - TEXT_CODE_WORD)
+
+#define TEXT_DICTIONARY_SIZE 175
+
+const char text_dictionary[] PROGMEM =
+	"the" "The" "to" "a" "and" "You" "is" "of"
+	"in" "you" "key" "light" "with" "up" "stairs" "are"
+	"A" "sword" "lead" "has" "on" "take" "Key" "It"
+	"it" "Stairs" "place" "water" "door" "down" "into" "key."
+	"room" "your" "curtain" "machine" "floor." "room." "seems" "small"
+	"have" "vial" "its" "see" "crystal" "liquid." "before" "broken"
+	"There" "from" "like" "next" "then" "this" "what" "you."
+	"bat" "for" "it." "one" "as" "diamond-shaped" "instruments" "contains"
+	"entrance" "window." "below." "copper" "rusted" "statue" "water." "window"
+	"blank" "chest" "curse" "dark." "down." "lamps" "large" "leads"
+	"looks" "lying" "table" "tower" "well." "Vial" "hall" "made"
+	"open" "pink" "rope" "they" "wall" "well" "One" "but"
+	"off" "too" "In" "an" "be" "no" "Everything" "chemicals."
+	"containing" "darkness." "something" "copying." "crystal." "cutting." "glitters" "kneeling"
+	"machine." "angelic" "barrels" "broken." "cutting" "descend" "elegant" "energy."
+	"moments" "quickly" "spilled" "stained" "statue." "symbols" "undeath" "around"
+	"ascend" "behind" "breast" "circle" "covers" "items!" "knight" "later,"
+	"light." "middle" "return" "silver" "sturdy" "tastes" "tower." "yellow"
+	"cover" "door." "doors" "drink" "fangs" "first" "floor" "foul."
+	"leave" "magic" "other" "plate" "rope." "sharp" "solid" "stone"
+	"there" "tools" "wall," "Next" "This" "Well" "copy" "cut."
+	"dark" "find" "glow" "goes" "hand" "iron" "long"
+	;
+
+const uint16_t text_dictionary_offsets[TEXT_DICTIONARY_SIZE + 1] PROGMEM = {
+	0, 3, 6, 8, 9, 12, 15, 17, 19, 21, 24, 27,
+	32, 36, 38, 44, 47, 48, 53, 57, 60, 62, 66, 69,
+	71, 73, 79, 84, 89, 93, 97, 101, 105, 109, 113, 120,
+	127, 133, 138, 143, 148, 152, 156, 159, 162, 169, 176, 182,
+	188, 193, 197, 201, 205, 209, 213, 217, 221, 224, 227, 230,
+	233, 235, 249, 260, 268, 276, 283, 289, 295, 301, 307, 313,
+	319, 324, 329, 334, 339, 344, 349, 354, 359, 364, 369, 374,
+	379, 384, 388, 392, 396, 400, 404, 408, 412, 416, 420, 423,
+	426, 429, 432, 434, 436, 438, 440, 450, 460, 470, 479, 488,
+	496, 504, 512, 520, 528, 536, 543, 550, 557, 564, 571, 578,
+	585, 592, 599, 606, 613, 620, 627, 634, 640, 646, 652, 658,
+	664, 670, 676, 682, 688, 694, 700, 706, 712, 718, 724, 730,
+	736, 741, 746, 751, 756, 761, 766, 771, 776, 781, 786, 791,
+	796, 801, 806, 811, 816, 821, 826, 831, 835, 839, 843, 847,
+	851, 855, 859, 863, 867, 871, 875, 879,
+};
+
+const uint8_t text_streams[] PROGMEM = {
+	// "Look"
+	0x04, 0x4c, 0x6f, 0x6f, 0x6b, 0x00,
+	// "Take"
+	0x04, 0x54, 0x61, 0x6b, 0x65, 0x00,
+	// "Use"
+	0x03, 0x55, 0x73, 0x65, 0x00,
+	// "Item"
+	0x04, 0x49, 0x74, 0x65, 0x6d, 0x00,
+	// "Continue"
+	0x08, 0x43, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x65, 0x00,
+	// "Crystal"
+	0x07, 0x43, 0x72, 0x79, 0x73, 0x74, 0x61, 0x6c, 0x00,
+	// "Lamp"
+	0x04, 0x4c, 0x61, 0x6d, 0x70, 0x00,
+	// "Silver Sword"
+	0x06, 0x53, 0x69, 0x6c, 0x76, 0x65, 0x72, 0x05, 0x53, 0x77, 0x6f, 0x72, 0x64, 0x00,
+	// "Broken Key"
+	0x06, 0x42, 0x72, 0x6f, 0x6b, 0x65, 0x6e, 0x57, 0x00,
+	// "Blank Key"
+	0x05, 0x42, 0x6c, 0x61, 0x6e, 0x6b, 0x57, 0x00,
+	// "Modified Key"
+	0x08, 0x4d, 0x6f, 0x64, 0x69, 0x66, 0x69, 0x65, 0x64, 0x57, 0x00,
+	// "Curtain"
+	0x07, 0x43, 0x75, 0x72, 0x74, 0x61, 0x69, 0x6e, 0x00,
+	// "Copied Key"
+	0x06, 0x43, 0x6f, 0x70, 0x69, 0x65, 0x64, 0x57, 0x00,
+	// "Copper Key"
+	0x06, 0x43, 0x6f, 0x70, 0x70, 0x65, 0x72, 0x57, 0x00,
+	// "Rope"
+	0x04, 0x52, 0x6f, 0x70, 0x65, 0x00,
+	// "Water"
+	0x05, 0x57, 0x61, 0x74, 0x65, 0x72, 0x00,
+	// "Key"
+	0x57, 0x00,
+	// "Stairs up"
+	0x5a, 0x4e, 0x00,
+	// "Stairs down"
+	0x5a, 0x5e, 0x00,
+	// "Barrels"
+	0x07, 0x42, 0x61, 0x72, 0x72, 0x65, 0x6c, 0x73, 0x00,
+	// "Well"
+	0xe6, 0x00,
+	// "Large Bat"
+	0x05, 0x4c, 0x61, 0x72, 0x67, 0x65, 0x03, 0x42, 0x61, 0x74, 0x00,
+	// "Darkness"
+	0x08, 0x44, 0x61, 0x72, 0x6b, 0x6e, 0x65, 0x73, 0x73, 0x00,
+	// "Pink Vial"
+	0x04, 0x50, 0x69, 0x6e, 0x6b, 0x96, 0x00,
+	// "Yellow Vial"
+	0x06, 0x59, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x96, 0x00,
+	// "Vial"
+	0x96, 0x00,
+	// "Door"
+	0x04, 0x44, 0x6f, 0x6f, 0x72, 0x00,
+	// "Chest"
+	0x05, 0x43, 0x68, 0x65, 0x73, 0x74, 0x00,
+	// "Table"
+	0x05, 0x54, 0x61, 0x62, 0x6c, 0x65, 0x00,
+	// "Key Machine"
+	0x57, 0x07, 0x4d, 0x61, 0x63, 0x68, 0x69, 0x6e, 0x65, 0x00,
+	// "Window"
+	0x06, 0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x00,
+	// "Angel Statue"
+	0x05, 0x41, 0x6e, 0x67, 0x65, 0x6c, 0x06, 0x53, 0x74, 0x61, 0x74, 0x75, 0x65, 0x00,
+	// "Entrance"
+	0x08, 0x45, 0x6e, 0x74, 0x72, 0x61, 0x6e, 0x63, 0x65, 0x00,
+	// ""
+	0x40, 0x00,
+	// "Nothing happens."
+	0x07, 0x4e, 0x6f, 0x74, 0x68, 0x69, 0x6e, 0x67, 0x08, 0x68, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x73,
+	0x2e, 0x00,
+	// "You are carrying no useful items!"
+	0x46, 0x50, 0x08, 0x63, 0x61, 0x72, 0x72, 0x79, 0x69, 0x6e, 0x67, 0xa6, 0x06, 0x75, 0x73, 0x65,
+	0x66, 0x75, 0x6c, 0xc6, 0x00,
+	// "The door is shut tight. You cannot open it."
+	0x42, 0x5d, 0x47, 0x04, 0x73, 0x68, 0x75, 0x74, 0x06, 0x74, 0x69, 0x67, 0x68, 0x74, 0x2e, 0x46,
+	0x06, 0x63, 0x61, 0x6e, 0x6e, 0x6f, 0x74, 0x99, 0x7b, 0x00,
+	// "Stairs lead up to the first floor of the abandoned tower...."
+	0x5a, 0x53, 0x4e, 0x43, 0x41, 0xd6, 0xd7, 0x48, 0x41, 0x09, 0x61, 0x62, 0x61, 0x6e, 0x64, 0x6f,
+	0x6e, 0x65, 0x64, 0xcf, 0x51, 0x94, 0x07, 0x66, 0x6c, 0x6f, 0x77, 0x69, 0x6e, 0x67, 0x4d, 0x77,
+	0x06, 0x41, 0x6e, 0x67, 0x65, 0x6c, 0x73, 0x05, 0x66, 0x65, 0x61, 0x72, 0x3b, 0x41, 0x8c, 0x46,
+	0xc1, 0x06, 0x68, 0x6f, 0x70, 0x69, 0x6e, 0x67, 0x43, 0xea, 0x44, 0x03, 0x77, 0x61, 0x79, 0x43,
+	0x05, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x41, 0x8b, 0x48, 0xbf, 0x04, 0x74, 0x68, 0x61, 0x74, 0x54,
+	0x04, 0x63, 0x6f, 0x6d, 0x65, 0x04, 0x75, 0x70, 0x6f, 0x6e, 0x78, 0x42, 0x07, 0x74, 0x6f, 0x77,
+	0x65, 0x72, 0x27, 0x73, 0xd3, 0x05, 0x63, 0x6c, 0x6f, 0x73, 0x65, 0xc2, 0x78, 0x46, 0x50, 0x08,
+	0x74, 0x72, 0x61, 0x70, 0x70, 0x65, 0x64, 0x21, 0x00,
+	// "You wake up in the entrance hall of the tower. Not sure o..."
+	0x46, 0x04, 0x77, 0x61, 0x6b, 0x65, 0x4e, 0x49, 0x41, 0x81, 0x97, 0x48, 0x41, 0xcf, 0x03, 0x4e,
+	0x6f, 0x74, 0x04, 0x73, 0x75, 0x72, 0x65, 0x48, 0x77, 0x54, 0x09, 0x68, 0x61, 0x70, 0x70, 0x65,
+	0x6e, 0x65, 0x64, 0x2c, 0x4a, 0xea, 0x4a, 0x69, 0x04, 0x6c, 0x6f, 0x73, 0x74, 0x62, 0xc6, 0x00,
+	// "You take the pink vial and drink it. It tastes foul. A fe..."
+	0x46, 0x56, 0x41, 0x9a, 0x6a, 0x45, 0xd4, 0x7b, 0x58, 0xce, 0xd8, 0x51, 0x03, 0x66, 0x65, 0x77,
+	0xb9, 0xc8, 0x4a, 0x05, 0x73, 0x74, 0x61, 0x72, 0x74, 0x08, 0x63, 0x6f, 0x75, 0x67, 0x68, 0x69,
+	0x6e, 0x67, 0x05, 0x62, 0x6c, 0x6f, 0x6f, 0x64, 0x09, 0x76, 0x69, 0x6f, 0x6c, 0x65, 0x6e, 0x74,
+	0x6c, 0x79, 0x45, 0x09, 0x63, 0x6f, 0x6c, 0x6c, 0x61, 0x70, 0x73, 0x65, 0x2e, 0xa7, 0xec, 0x8c,
+	0x00,
+	// "You take the yellow vial and drink it. It tastes foul. A ..."
+	0x46, 0x56, 0x41, 0xd0, 0x6a, 0x45, 0xd4, 0x7b, 0x58, 0xce, 0xd8, 0x51, 0x03, 0x66, 0x65, 0x77,
+	0xb9, 0xc8, 0x4a, 0x04, 0x66, 0x65, 0x65, 0x6c, 0x06, 0x77, 0x61, 0x72, 0x6d, 0x74, 0x68, 0xcb,
+	0x43, 0x62, 0x05, 0x62, 0x6f, 0x64, 0x79, 0x2e, 0x46, 0x08, 0x73, 0x74, 0x61, 0x72, 0x74, 0x69,
+	0x6e, 0x67, 0x09, 0x62, 0x72, 0x65, 0x61, 0x74, 0x68, 0x69, 0x6e, 0x67, 0x06, 0x61, 0x67, 0x61,
+	0x69, 0x6e, 0x2e, 0x42, 0x06, 0x70, 0x6f, 0x74, 0x69, 0x6f, 0x6e, 0x54, 0x05, 0x63, 0x75, 0x72,
+	0x65, 0x64, 0x4a, 0x48, 0x41, 0x8b, 0x48, 0x08, 0x75, 0x6e, 0x64, 0x65, 0x61, 0x74, 0x68, 0x21,
+	0x00,
+	// "You leave the tower feeling reborn. The ordeal of the tow..."
+	0x46, 0xd9, 0x41, 0x94, 0x07, 0x66, 0x65, 0x65, 0x6c, 0x69, 0x6e, 0x67, 0x07, 0x72, 0x65, 0x62,
+	0x6f, 0x72, 0x6e, 0x2e, 0x42, 0x06, 0x6f, 0x72, 0x64, 0x65, 0x61, 0x6c, 0x48, 0x41, 0x94, 0x03,
+	0x6d, 0x61, 0x79, 0x9e, 0x04, 0x6c, 0x69, 0x76, 0x65, 0x4d, 0x4a, 0x08, 0x66, 0x6f, 0x72, 0x65,
+	0x76, 0x65, 0x72, 0x2c, 0xa0, 0x03, 0x6e, 0x6f, 0x77, 0xa6, 0x06, 0x6c, 0x6f, 0x6e, 0x67, 0x65,
+	0x72, 0x07, 0x62, 0x65, 0x61, 0x72, 0x69, 0x6e, 0x67, 0x41, 0x8b, 0x48, 0xbf, 0x4a, 0x03, 0x63,
+	0x61, 0x6e, 0x07, 0x65, 0x78, 0x70, 0x6c, 0x6f, 0x72, 0x65, 0x45, 0x05, 0x65, 0x6e, 0x6a, 0x6f,
+	0x79, 0x0a, 0x65, 0x76, 0x65, 0x72, 0x79, 0x74, 0x68, 0x69, 0x6e, 0x67, 0x41, 0x05, 0x77, 0x6f,
+	0x72, 0x6c, 0x64, 0x54, 0x43, 0x06, 0x6f, 0x66, 0x66, 0x65, 0x72, 0x2e, 0x00,
+	// "Well Done! You have won! If you would like to play again,..."
+	0xe6, 0x05, 0x44, 0x6f, 0x6e, 0x65, 0x21, 0x46, 0x69, 0x04, 0x77, 0x6f, 0x6e, 0x21, 0x02, 0x49,
+	0x66, 0x4a, 0x05, 0x77, 0x6f, 0x75, 0x6c, 0x64, 0x73, 0x43, 0x04, 0x70, 0x6c, 0x61, 0x79, 0x06,
+	0x61, 0x67, 0x61, 0x69, 0x6e, 0x2c, 0x75, 0x06, 0x70, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x09, 0x63,
+	0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x65, 0x2e, 0x00,
+	// "The water comes up to your waist, it feels cold."
+	0x42, 0x5c, 0x05, 0x63, 0x6f, 0x6d, 0x65, 0x73, 0x4e, 0x43, 0x62, 0x06, 0x77, 0x61, 0x69, 0x73,
+	0x74, 0x2c, 0x59, 0x05, 0x66, 0x65, 0x65, 0x6c, 0x73, 0x05, 0x63, 0x6f, 0x6c, 0x64, 0x2e, 0x00,
+	// " You can see what looks like a crystal in the water."
+	0x40, 0x46, 0x03, 0x63, 0x61, 0x6e, 0x6c, 0x77, 0x91, 0x73, 0x44, 0x6d, 0x49, 0x41, 0x87, 0x00,
+	// "The water is clear and stagnant."
+	0x42, 0x5c, 0x47, 0x05, 0x63, 0x6c, 0x65, 0x61, 0x72, 0x45, 0x09, 0x73, 0x74, 0x61, 0x67, 0x6e,
+	0x61, 0x6e, 0x74, 0x2e, 0x00,
+	// "The rope hangs down from above."
+	0x42, 0x9b, 0x05, 0x68, 0x61, 0x6e, 0x67, 0x73, 0x5e, 0x72, 0x06, 0x61, 0x62, 0x6f, 0x76, 0x65,
+	0x2e, 0x00,
+	// "The diamond-shaped crystal seems to glow with magical ene..."
+	0x42, 0x7e, 0x6d, 0x67, 0x43, 0xeb, 0x4d, 0x07, 0x6d, 0x61, 0x67, 0x69, 0x63, 0x61, 0x6c, 0xb8,
+	0x00,
+	// "The key is has a no cuttings on its head. It is like a bl..."
+	0x42, 0x4b, 0x47, 0x54, 0x44, 0xa6, 0x08, 0x63, 0x75, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x55,
+	0x6b, 0x05, 0x68, 0x65, 0x61, 0x64, 0x2e, 0x58, 0x47, 0x73, 0x44, 0x89, 0x60, 0x00,
+	// "You notice in the light of the crystal there is a key in ..."
+	0x46, 0x06, 0x6e, 0x6f, 0x74, 0x69, 0x63, 0x65, 0x49, 0x41, 0x4c, 0x48, 0x41, 0x6d, 0xe1, 0x47,
+	0x44, 0x4b, 0x49, 0x87, 0x00,
+	// "You take the diamond-shaped crystal. The key in the water..."
+	0x46, 0x56, 0x41, 0x7e, 0xad, 0x42, 0x4b, 0x49, 0x41, 0x5c, 0x05, 0x66, 0x61, 0x64, 0x65, 0x73,
+	0x5f, 0x0c, 0x6e, 0x6f, 0x74, 0x68, 0x69, 0x6e, 0x67, 0x6e, 0x65, 0x73, 0x73, 0x2e, 0x00,
+	// "You take the diamond-shaped crystal."
+	0x46, 0x56, 0x41, 0x7e, 0xad, 0x00,
+	// "You take the blank key."
+	0x46, 0x56, 0x41, 0x89, 0x60, 0x00,
+	// "The light from your lamp shows this is a store room with ..."
+	0x42, 0x4c, 0x72, 0x62, 0x04, 0x6c, 0x61, 0x6d, 0x70, 0x05, 0x73, 0x68, 0x6f, 0x77, 0x73, 0x76,
+	0x47, 0x44, 0x05, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x61, 0x4d, 0x04, 0x6d, 0x61, 0x6e, 0x79, 0x08,
+	0x62, 0x61, 0x72, 0x72, 0x65, 0x6c, 0x73, 0x2e, 0x71, 0x47, 0x44, 0x9e, 0x49, 0x41, 0xca, 0x48,
+	0x41, 0x66, 0x00,
+	// "The stairs lead up to the light of the entrance room."
+	0x42, 0x4f, 0x53, 0x4e, 0x43, 0x41, 0x4c, 0x48, 0x41, 0x81, 0x66, 0x00,
+	// "The barrels contain grain."
+	0x42, 0xb3, 0x07, 0x63, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x06, 0x67, 0x72, 0x61, 0x69, 0x6e,
+	0x2e, 0x00,
+	// "There seems to be water in the well."
+	0x71, 0x67, 0x43, 0xa5, 0x5c, 0x49, 0x41, 0x95, 0x00,
+	// "The long length of rope is made of hemp and looks strong."
+	0x42, 0xef, 0x06, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x48, 0x9b, 0x47, 0x98, 0x48, 0x04, 0x68,
+	0x65, 0x6d, 0x70, 0x45, 0x91, 0x07, 0x73, 0x74, 0x72, 0x6f, 0x6e, 0x67, 0x2e, 0x00,
+	// "One of the barrels contains some rope."
+	0x9f, 0x48, 0x41, 0xb3, 0x80, 0x04, 0x73, 0x6f, 0x6d, 0x65, 0xdd, 0x00,
+	// "There seems to be water in the well. Something glitters i..."
+	0x71, 0x67, 0x43, 0xa5, 0x5c, 0x49, 0x41, 0x95, 0x09, 0x53, 0x6f, 0x6d, 0x65, 0x74, 0x68, 0x69,
+	0x6e, 0x67, 0xaf, 0x49, 0x41, 0x4c, 0x05, 0x75, 0x6e, 0x64, 0x65, 0x72, 0x41, 0x07, 0x73, 0x68,
+	0x61, 0x6c, 0x6c, 0x6f, 0x77, 0x87, 0x00,
+	// "You gather the rope."
+	0x46, 0x06, 0x67, 0x61, 0x74, 0x68, 0x65, 0x72, 0x41, 0xdd, 0x00,
+	// "You tie the rope around the well."
+	0x46, 0x03, 0x74, 0x69, 0x65, 0x41, 0x9b, 0xc0, 0x41, 0x95, 0x00,
+	// "The water is still."
+	0x42, 0x5c, 0x47, 0x06, 0x73, 0x74, 0x69, 0x6c, 0x6c, 0x2e, 0x00,
+	// " Your light disturbs a large black creature, hanging from..."
+	0x40, 0x04, 0x59, 0x6f, 0x75, 0x72, 0x4c, 0x08, 0x64, 0x69, 0x73, 0x74, 0x75, 0x72, 0x62, 0x73,
+	0x44, 0x8f, 0x05, 0x62, 0x6c, 0x61, 0x63, 0x6b, 0x09, 0x63, 0x72, 0x65, 0x61, 0x74, 0x75, 0x72,
+	0x65, 0x2c, 0x07, 0x68, 0x61, 0x6e, 0x67, 0x69, 0x6e, 0x67, 0x72, 0x41, 0x08, 0x63, 0x65, 0x69,
+	0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x42, 0x8f, 0x79, 0x07, 0x75, 0x6e, 0x66, 0x6f, 0x6c, 0x64, 0x73,
+	0x6b, 0x05, 0x77, 0x69, 0x6e, 0x67, 0x73, 0x45, 0x07, 0x61, 0x74, 0x74, 0x61, 0x63, 0x6b, 0x73,
+	0x04, 0x79, 0x6f, 0x75, 0x21, 0x00,
+	// "The bat has a five foot wing span and very sharp fangs."
+	0x42, 0x79, 0x54, 0x44, 0x04, 0x66, 0x69, 0x76, 0x65, 0x04, 0x66, 0x6f, 0x6f, 0x74, 0x04, 0x77,
+	0x69, 0x6e, 0x67, 0x04, 0x73, 0x70, 0x61, 0x6e, 0x45, 0x04, 0x76, 0x65, 0x72, 0x79, 0xde, 0x06,
+	0x66, 0x61, 0x6e, 0x67, 0x73, 0x2e, 0x00,
+	// "While distracted the bat grabs you and sinks its fangs de..."
+	0x05, 0x57, 0x68, 0x69, 0x6c, 0x65, 0x0a, 0x64, 0x69, 0x73, 0x74, 0x72, 0x61, 0x63, 0x74, 0x65,
+	0x64, 0x41, 0x79, 0x05, 0x67, 0x72, 0x61, 0x62, 0x73, 0x4a, 0x45, 0x05, 0x73, 0x69, 0x6e, 0x6b,
+	0x73, 0x6b, 0xd5, 0x04, 0x64, 0x65, 0x65, 0x70, 0x5f, 0x62, 0x05, 0x6e, 0x65, 0x63, 0x6b, 0x2e,
+	0xa7, 0xec, 0x8c, 0x00,
+	// "The bat flies towards you, fangs ready to bite you. You q..."
+	0x42, 0x79, 0x05, 0x66, 0x6c, 0x69, 0x65, 0x73, 0x07, 0x74, 0x6f, 0x77, 0x61, 0x72, 0x64, 0x73,
+	0x04, 0x79, 0x6f, 0x75, 0x2c, 0xd5, 0x05, 0x72, 0x65, 0x61, 0x64, 0x79, 0x43, 0x04, 0x62, 0x69,
+	0x74, 0x65, 0x78, 0x46, 0xba, 0x04, 0x64, 0x72, 0x61, 0x77, 0x62, 0x52, 0x45, 0x05, 0x73, 0x77,
+	0x69, 0x6e, 0x67, 0x02, 0x61, 0x74, 0x41, 0x09, 0x63, 0x72, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65,
+	0x2e, 0x42, 0x52, 0x04, 0x63, 0x75, 0x74, 0x73, 0x41, 0x08, 0x63, 0x72, 0x65, 0x61, 0x74, 0x75,
+	0x72, 0x65, 0x45, 0x41, 0x04, 0x66, 0x65, 0x6c, 0x6c, 0x05, 0x62, 0x65, 0x61, 0x73, 0x74, 0x09,
+	0x73, 0x63, 0x72, 0x65, 0x65, 0x63, 0x68, 0x65, 0x73, 0x45, 0x06, 0x62, 0x75, 0x72, 0x73, 0x74,
+	0x73, 0x5f, 0x06, 0x66, 0x6c, 0x61, 0x6d, 0x65, 0x73, 0x6f, 0x0b, 0x65, 0x76, 0x61, 0x70, 0x6f,
+	0x72, 0x61, 0x74, 0x69, 0x6e, 0x67, 0x5f, 0x05, 0x6d, 0x69, 0x73, 0x74, 0x2e, 0x00,
+	// "You descend several steps, but it quickly gets too dark t..."
+	0x46, 0xb6, 0x07, 0x73, 0x65, 0x76, 0x65, 0x72, 0x61, 0x6c, 0x06, 0x73, 0x74, 0x65, 0x70, 0x73,
+	0x2c, 0xa0, 0x59, 0xba, 0x04, 0x67, 0x65, 0x74, 0x73, 0xa2, 0xe9, 0x43, 0x07, 0x70, 0x72, 0x6f,
+	0x63, 0x65, 0x65, 0x64, 0x08, 0x66, 0x75, 0x72, 0x74, 0x68, 0x65, 0x72, 0x2e, 0x00,
+	// "This area is too dark to see anything."
+	0xe5, 0x04, 0x61, 0x72, 0x65, 0x61, 0x47, 0xa2, 0xe9, 0x43, 0x6c, 0x09, 0x61, 0x6e, 0x79, 0x74,
+	0x68, 0x69, 0x6e, 0x67, 0x2e, 0x00,
+	// "The key slots in and turns. The chest unlocks and you ope..."
+	0x42, 0x4b, 0x05, 0x73, 0x6c, 0x6f, 0x74, 0x73, 0x49, 0x45, 0x06, 0x74, 0x75, 0x72, 0x6e, 0x73,
+	0x2e, 0x42, 0x8a, 0x07, 0x75, 0x6e, 0x6c, 0x6f, 0x63, 0x6b, 0x73, 0x45, 0x4a, 0x99, 0x7b, 0x42,
+	0x5d, 0x05, 0x73, 0x6c, 0x61, 0x6d, 0x73, 0x04, 0x73, 0x68, 0x75, 0x74, 0xc2, 0x78, 0x06, 0x49,
+	0x6e, 0x73, 0x69, 0x64, 0x65, 0x4a, 0x6c, 0x40, 0x00,
+	// "two vials, each containing a different coloured liquid."
+	0x03, 0x74, 0x77, 0x6f, 0x06, 0x76, 0x69, 0x61, 0x6c, 0x73, 0x2c, 0x04, 0x65, 0x61, 0x63, 0x68,
+	0xa9, 0x44, 0x09, 0x64, 0x69, 0x66, 0x66, 0x65, 0x72, 0x65, 0x6e, 0x74, 0x08, 0x63, 0x6f, 0x6c,
+	0x6f, 0x75, 0x72, 0x65, 0x64, 0x6e, 0x00,
+	// "a vial containing a pink liquid."
+	0x44, 0x6a, 0xa9, 0x44, 0x9a, 0x6e, 0x00,
+	// "The small vial contains a pink liquid."
+	0x42, 0x68, 0x6a, 0x80, 0x44, 0x9a, 0x6e, 0x00,
+	// "The small vial contains a yellow liquid."
+	0x42, 0x68, 0x6a, 0x80, 0x44, 0xd0, 0x6e, 0x00,
+	// "Four arrow-slit windows cast a dim light in this room. A ..."
+	0x04, 0x46, 0x6f, 0x75, 0x72, 0x0a, 0x61, 0x72, 0x72, 0x6f, 0x77, 0x2d, 0x73, 0x6c, 0x69, 0x74,
+	0x07, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x04, 0x63, 0x61, 0x73, 0x74, 0x44, 0x03, 0x64,
+	0x69, 0x6d, 0x4c, 0x49, 0x76, 0x66, 0x51, 0x8a, 0x06, 0x73, 0x74, 0x61, 0x6e, 0x64, 0x73, 0x49,
+	0x41, 0xca, 0x48, 0x41, 0x66, 0x00,
+	// "The chest is sturdy with iron bands and a lock built in. ..."
+	0x42, 0x8a, 0x47, 0xcd, 0x4d, 0xee, 0x05, 0x62, 0x61, 0x6e, 0x64, 0x73, 0x45, 0x44, 0x04, 0x6c,
+	0x6f, 0x63, 0x6b, 0x05, 0x62, 0x75, 0x69, 0x6c, 0x74, 0x03, 0x69, 0x6e, 0x2e, 0x05, 0x43, 0x6f,
+	0x75, 0x6c, 0x64, 0x76, 0x69, 0x41, 0x04, 0x63, 0x75, 0x72, 0x65, 0x4a, 0x50, 0x07, 0x6c, 0x6f,
+	0x6f, 0x6b, 0x69, 0x6e, 0x67, 0x04, 0x66, 0x6f, 0x72, 0x3f, 0x00,
+	// "The stairs lead down to the floor below."
+	0x42, 0x4f, 0x53, 0x5e, 0x43, 0x41, 0xd7, 0x83, 0x00,
+	// "You try to move the chest, but it won't budge. It is like..."
+	0x46, 0x03, 0x74, 0x72, 0x79, 0x43, 0x04, 0x6d, 0x6f, 0x76, 0x65, 0x41, 0x06, 0x63, 0x68, 0x65,
+	0x73, 0x74, 0x2c, 0xa0, 0x59, 0x05, 0x77, 0x6f, 0x6e, 0x27, 0x74, 0x06, 0x62, 0x75, 0x64, 0x67,
+	0x65, 0x2e, 0x58, 0x47, 0x73, 0x59, 0x47, 0x04, 0x68, 0x65, 0x6c, 0x64, 0x49, 0x5b, 0x02, 0x62,
+	0x79, 0x04, 0x73, 0x6f, 0x6d, 0x65, 0x06, 0x66, 0x6f, 0x72, 0x63, 0x65, 0x2e, 0x00,
+	// "You place the crystal in the door. The magic circle and t..."
+	0x46, 0x5b, 0x41, 0x6d, 0x49, 0x41, 0xd2, 0x42, 0xda, 0xc4, 0x45, 0x41, 0xbe, 0xeb, 0x07, 0x66,
+	0x61, 0x69, 0x6e, 0x74, 0x6c, 0x79, 0x45, 0x03, 0x68, 0x75, 0x6d, 0x4d, 0xb8, 0x04, 0x57, 0x69,
+	0x74, 0x68, 0x44, 0x04, 0x6c, 0x6f, 0x75, 0x64, 0x08, 0x67, 0x72, 0x69, 0x6e, 0x64, 0x69, 0x6e,
+	0x67, 0x06, 0x73, 0x6f, 0x75, 0x6e, 0x64, 0x2c, 0x41, 0x5d, 0x06, 0x73, 0x77, 0x69, 0x6e, 0x67,
+	0x73, 0x99, 0x43, 0x06, 0x72, 0x65, 0x76, 0x65, 0x61, 0x6c, 0x41, 0x61, 0x07, 0x62, 0x65, 0x79,
+	0x6f, 0x6e, 0x64, 0x2e, 0x00,
+	// "You ascend the stairs to the next floor. A solid oak door..."
+	0x46, 0xc1, 0x41, 0x4f, 0x43, 0x41, 0x74, 0x65, 0x51, 0xdf, 0x03, 0x6f, 0x61, 0x6b, 0x5d, 0x06,
+	0x61, 0x77, 0x61, 0x69, 0x74, 0x73, 0x4a, 0x02, 0x61, 0x74, 0x41, 0x03, 0x74, 0x6f, 0x70, 0x48,
+	0x41, 0x07, 0x73, 0x74, 0x61, 0x69, 0x72, 0x73, 0x2e, 0x00,
+	// "Stairs Down"
+	0x5a, 0x04, 0x44, 0x6f, 0x77, 0x6e, 0x00,
+	// "The stairs lead down to the hall below."
+	0x42, 0x4f, 0x53, 0x5e, 0x43, 0x41, 0x97, 0x83, 0x00,
+	// "The solid oak door is sturdy and is locked. A magic circl..."
+	0x42, 0xdf, 0x03, 0x6f, 0x61, 0x6b, 0x5d, 0x47, 0xcd, 0x45, 0x47, 0x07, 0x6c, 0x6f, 0x63, 0x6b,
+	0x65, 0x64, 0x2e, 0x51, 0xda, 0xc4, 0x4d, 0x07, 0x73, 0x74, 0x72, 0x61, 0x6e, 0x67, 0x65, 0xbe,
+	0x04, 0x6d, 0x61, 0x72, 0x6b, 0x41, 0xd2, 0xa3, 0x41, 0x06, 0x63, 0x65, 0x6e, 0x74, 0x72, 0x65,
+	0x47, 0x44, 0x07, 0x64, 0x69, 0x61, 0x6d, 0x6f, 0x6e, 0x64, 0x06, 0x73, 0x68, 0x61, 0x70, 0x65,
+	0x64, 0x05, 0x68, 0x6f, 0x6c, 0x65, 0x2e, 0x00,
+	// "At opposite ends of the room are stairs; one leads up, on..."
+	0x02, 0x41, 0x74, 0x08, 0x6f, 0x70, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x65, 0x04, 0x65, 0x6e, 0x64,
+	0x73, 0x48, 0x41, 0x61, 0x50, 0x07, 0x73, 0x74, 0x61, 0x69, 0x72, 0x73, 0x3b, 0x7c, 0x90, 0x03,
+	0x75, 0x70, 0x2c, 0x7c, 0x90, 0x8d, 0x71, 0x47, 0x44, 0x93, 0x48, 0x0a, 0x61, 0x6c, 0x63, 0x68,
+	0x65, 0x6d, 0x69, 0x63, 0x61, 0x6c, 0x7f, 0x45, 0x70, 0x06, 0x67, 0x6c, 0x61, 0x73, 0x73, 0x2e,
+	0x00,
+	// " Next to it is a key-cutting machine."
+	0x40, 0xe4, 0x43, 0x59, 0x47, 0x44, 0x0b, 0x6b, 0x65, 0x79, 0x2d, 0x63, 0x75, 0x74, 0x74, 0x69,
+	0x6e, 0x67, 0xb1, 0x00,
+	// " Next to it a dusty curtain covers something large."
+	0x40, 0xe4, 0x43, 0x59, 0x44, 0x05, 0x64, 0x75, 0x73, 0x74, 0x79, 0x63, 0xc5, 0xab, 0x06, 0x6c,
+	0x61, 0x72, 0x67, 0x65, 0x2e, 0x00,
+	// "The table is stained with spilled chemicals. The tools an..."
+	0x42, 0x93, 0x47, 0xbc, 0x4d, 0xbb, 0xa8, 0x42, 0xe2, 0x45, 0x7f, 0x50, 0x85, 0x45, 0xb4, 0xa3,
+	0x07, 0x61, 0x6d, 0x6f, 0x6e, 0x67, 0x73, 0x74, 0x41, 0x04, 0x6d, 0x65, 0x73, 0x73, 0xe1, 0x47,
+	0x44, 0x84, 0x60, 0x00,
+	// "The table is stained with spilled chemicals. The tools an..."
+	0x42, 0x93, 0x47, 0xbc, 0x4d, 0xbb, 0xa8, 0x42, 0xe2, 0x45, 0x7f, 0x50, 0x85, 0x45, 0xb4, 0x00,
+	// "The elegant red curtain with gold trim completely covers ..."
+	0x42, 0xb7, 0x03, 0x72, 0x65, 0x64, 0x63, 0x4d, 0x04, 0x67, 0x6f, 0x6c, 0x64, 0x04, 0x74, 0x72,
+	0x69, 0x6d, 0x0a, 0x63, 0x6f, 0x6d, 0x70, 0x6c, 0x65, 0x74, 0x65, 0x6c, 0x79, 0xc5, 0xab, 0x8f,
+	0x45, 0x03, 0x62, 0x6f, 0x78, 0x07, 0x73, 0x68, 0x61, 0x70, 0x65, 0x64, 0x2e, 0x00,
+	// "The key cutting machine seems to take first the key you w..."
+	0x42, 0x4b, 0xb5, 0x64, 0x67, 0x43, 0x56, 0xd6, 0x41, 0x4b, 0x4a, 0x04, 0x77, 0x69, 0x73, 0x68,
+	0x43, 0xe7, 0x45, 0x75, 0x41, 0x03, 0x63, 0x75, 0x74, 0x4a, 0x04, 0x77, 0x69, 0x73, 0x68, 0x43,
+	0xe8, 0x00,
+	// "The stairs wind up to the next floor."
+	0x42, 0x4f, 0x04, 0x77, 0x69, 0x6e, 0x64, 0x4e, 0x43, 0x41, 0x74, 0x65, 0x00,
+	// "The stairs lead down to the faint light of the hall below."
+	0x42, 0x4f, 0x53, 0x5e, 0x43, 0x41, 0x05, 0x66, 0x61, 0x69, 0x6e, 0x74, 0x4c, 0x48, 0x41, 0x97,
+	0x83, 0x00,
+	// "The key is small and made of copper. It has an elegant fl..."
+	0x42, 0x4b, 0x47, 0x68, 0x45, 0x98, 0x48, 0x07, 0x63, 0x6f, 0x70, 0x70, 0x65, 0x72, 0x2e, 0x58,
+	0x54, 0xa4, 0xb7, 0x06, 0x66, 0x6c, 0x6f, 0x72, 0x61, 0x6c, 0x07, 0x70, 0x61, 0x74, 0x74, 0x65,
+	0x72, 0x6e, 0x55, 0x41, 0x07, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x2e, 0x00,
+	// "You use the machine and get a new key."
+	0x46, 0x03, 0x75, 0x73, 0x65, 0x41, 0x64, 0x45, 0x03, 0x67, 0x65, 0x74, 0x44, 0x03, 0x6e, 0x65,
+	0x77, 0x60, 0x00,
+	// "First place a key to copy then one to cut. To reset choic..."
+	0x05, 0x46, 0x69, 0x72, 0x73, 0x74, 0x5b, 0x44, 0x4b, 0x43, 0xe7, 0x75, 0x7c, 0x43, 0xe8, 0x02,
+	0x54, 0x6f, 0x05, 0x72, 0x65, 0x73, 0x65, 0x74, 0x08, 0x63, 0x68, 0x6f, 0x69, 0x63, 0x65, 0x73,
+	0x2c, 0xd9, 0x45, 0xcb, 0x43, 0x76, 0x66, 0x00,
+	// "You collect the curtain and uncover what seems to be a ke..."
+	0x46, 0x07, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x41, 0x63, 0x45, 0x07, 0x75, 0x6e, 0x63,
+	0x6f, 0x76, 0x65, 0x72, 0x77, 0x67, 0x43, 0xa5, 0x44, 0x4b, 0xb5, 0xb1, 0x00,
+	// "You pick up the small copper key."
+	0x46, 0x04, 0x70, 0x69, 0x63, 0x6b, 0x4e, 0x41, 0x68, 0x84, 0x60, 0x00,
+	// "This key looks okay. It doesn't need copying."
+	0xe5, 0x4b, 0x91, 0x05, 0x6f, 0x6b, 0x61, 0x79, 0x2e, 0x58, 0x07, 0x64, 0x6f, 0x65, 0x73, 0x6e,
+	0x27, 0x74, 0x04, 0x6e, 0x65, 0x65, 0x64, 0xac, 0x00,
+	// "You place the broken key in the machine for copying."
+	0x46, 0x5b, 0x41, 0x70, 0x4b, 0x49, 0x41, 0x64, 0x7a, 0xac, 0x00,
+	// "You place the copper key in the machine for cutting."
+	0x46, 0x5b, 0x41, 0x84, 0x4b, 0x49, 0x41, 0x64, 0x7a, 0xae, 0x00,
+	// "You place the blank key in the machine for cutting."
+	0x46, 0x5b, 0x41, 0x89, 0x4b, 0x49, 0x41, 0x64, 0x7a, 0xae, 0x00,
+	// "A barred window casts a ray of light over a statue of a k..."
+	0x51, 0x06, 0x62, 0x61, 0x72, 0x72, 0x65, 0x64, 0x88, 0x05, 0x63, 0x61, 0x73, 0x74, 0x73, 0x44,
+	0x03, 0x72, 0x61, 0x79, 0x48, 0x4c, 0x04, 0x6f, 0x76, 0x65, 0x72, 0x44, 0x86, 0x48, 0x44, 0x08,
+	0x6b, 0x6e, 0x69, 0x67, 0x68, 0x74, 0x6c, 0x79, 0x06, 0x61, 0x6e, 0x67, 0x65, 0x6c, 0x2e, 0x5a,
+	0x08, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x65, 0x43, 0x53, 0x4e, 0x7d, 0x9e, 0x7d, 0x8d,
+	0x00,
+	// " The sword is lying on the ground before the statue."
+	0x40, 0x42, 0x52, 0x47, 0x92, 0x55, 0x41, 0x06, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x6f, 0x41,
+	0xbd, 0x00,
+	// "The lonely window has rusted iron bars. A broken rail cli..."
+	0x42, 0x06, 0x6c, 0x6f, 0x6e, 0x65, 0x6c, 0x79, 0x88, 0x54, 0x85, 0xee, 0x05, 0x62, 0x61, 0x72,
+	0x73, 0x2e, 0x51, 0x70, 0x04, 0x72, 0x61, 0x69, 0x6c, 0x06, 0x63, 0x6c, 0x69, 0x6e, 0x67, 0x73,
+	0x43, 0x41, 0x9d, 0x05, 0x61, 0x62, 0x6f, 0x76, 0x65, 0x41, 0x82, 0x00,
+	// "The statue is of an angelic knight kneeling before the li..."
+	0x42, 0x86, 0x47, 0x48, 0xa4, 0xb2, 0xc7, 0xb0, 0x6f, 0x41, 0x4c, 0x48, 0x41, 0x82, 0x9f, 0xed,
+	0x55, 0x6b, 0xc3, 0xdc, 0x41, 0xdb, 0x07, 0x68, 0x6f, 0x6c, 0x64, 0x69, 0x6e, 0x67, 0x44, 0xcc,
+	0x52, 0x0d, 0x75, 0x70, 0x2d, 0x73, 0x69, 0x64, 0x65, 0x2d, 0x64, 0x6f, 0x77, 0x6e, 0x2e, 0x00,
+	// "The statue is of an angelic knight kneeling before the wi..."
+	0x42, 0x86, 0x47, 0x48, 0xa4, 0xb2, 0xc7, 0xb0, 0x6f, 0x41, 0x82, 0x9f, 0xed, 0x55, 0x6b, 0xc3,
+	0xdc, 0x41, 0xdb, 0x08, 0x72, 0x65, 0x61, 0x63, 0x68, 0x69, 0x6e, 0x67, 0x03, 0x6f, 0x75, 0x74,
+	0x49, 0x08, 0x64, 0x65, 0x73, 0x70, 0x61, 0x69, 0x72, 0x2e, 0x00,
+	// "The stairs lead up to the next floor."
+	0x42, 0x4f, 0x53, 0x4e, 0x43, 0x41, 0x74, 0x65, 0x00,
+	// "Stairs lead down to a warm glow."
+	0x5a, 0x53, 0x5e, 0x43, 0x44, 0x04, 0x77, 0x61, 0x72, 0x6d, 0x05, 0x67, 0x6c, 0x6f, 0x77, 0x2e,
+	0x00,
+	// "The sword glitters beautifully in the light. It carries a..."
+	0x42, 0x52, 0xaf, 0x0b, 0x62, 0x65, 0x61, 0x75, 0x74, 0x69, 0x66, 0x75, 0x6c, 0x6c, 0x79, 0x49,
+	0x41, 0xc9, 0x58, 0x07, 0x63, 0x61, 0x72, 0x72, 0x69, 0x65, 0x73, 0x44, 0xde, 0x05, 0x65, 0x64,
+	0x67, 0x65, 0x2e, 0x00,
+	// "The sword is lying on the stone floor, light reflects off..."
+	0x42, 0x52, 0x47, 0x92, 0x55, 0x41, 0xe0, 0x06, 0x66, 0x6c, 0x6f, 0x6f, 0x72, 0x2c, 0x4c, 0x08,
+	0x72, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x73, 0xa1, 0x59, 0x04, 0x6f, 0x6e, 0x74, 0x6f, 0x41,
+	0xe3, 0x05, 0x77, 0x68, 0x69, 0x63, 0x68, 0x07, 0x62, 0x65, 0x63, 0x6f, 0x6d, 0x65, 0x73, 0x0b,
+	0x74, 0x72, 0x61, 0x6e, 0x73, 0x6c, 0x75, 0x63, 0x65, 0x6e, 0x74, 0x09, 0x72, 0x65, 0x76, 0x65,
+	0x61, 0x6c, 0x69, 0x6e, 0x67, 0x44, 0x06, 0x63, 0x61, 0x63, 0x68, 0x65, 0x2e, 0xa3, 0x41, 0x05,
+	0x63, 0x61, 0x63, 0x68, 0x65, 0x4a, 0x6c, 0x44, 0x60, 0x00,
+	// "The sword is in perfect condition and glistens silver in ..."
+	0x42, 0x52, 0x47, 0x49, 0x07, 0x70, 0x65, 0x72, 0x66, 0x65, 0x63, 0x74, 0x09, 0x63, 0x6f, 0x6e,
+	0x64, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x45, 0x08, 0x67, 0x6c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x73,
+	0xcc, 0x49, 0x41, 0xc9, 0x00,
+	// "You are unable to release the sword from the statue's grip."
+	0x46, 0x50, 0x06, 0x75, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x43, 0x07, 0x72, 0x65, 0x6c, 0x65, 0x61,
+	0x73, 0x65, 0x41, 0x52, 0x72, 0x41, 0x08, 0x73, 0x74, 0x61, 0x74, 0x75, 0x65, 0x27, 0x73, 0x05,
+	0x67, 0x72, 0x69, 0x70, 0x2e, 0x00,
+	// "The key's handle is broken off and missing."
+	0x42, 0x05, 0x6b, 0x65, 0x79, 0x27, 0x73, 0x06, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x47, 0x70,
+	0xa1, 0x45, 0x08, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6e, 0x67, 0x2e, 0x00,
+	// "You cover the window with the curtain. The room is cloake..."
+	0x46, 0xd1, 0x41, 0x88, 0x4d, 0x41, 0x08, 0x63, 0x75, 0x72, 0x74, 0x61, 0x69, 0x6e, 0x2e, 0x42,
+	0x61, 0x47, 0x07, 0x63, 0x6c, 0x6f, 0x61, 0x6b, 0x65, 0x64, 0x49, 0xaa, 0x51, 0x04, 0x68, 0x69,
+	0x67, 0x68, 0x05, 0x70, 0x69, 0x74, 0x63, 0x68, 0x06, 0x73, 0x63, 0x72, 0x65, 0x61, 0x6d, 0x06,
+	0x65, 0x63, 0x68, 0x6f, 0x65, 0x73, 0x49, 0x41, 0x61, 0x45, 0x75, 0x44, 0x05, 0x63, 0x6c, 0x61,
+	0x6e, 0x67, 0x48, 0x06, 0x6d, 0x65, 0x74, 0x61, 0x6c, 0x2e, 0x46, 0x04, 0x64, 0x72, 0x6f, 0x70,
+	0x41, 0x63, 0x43, 0x6c, 0x41, 0x52, 0x47, 0x03, 0x6e, 0x6f, 0x77, 0x92, 0x55, 0x41, 0x65, 0x00,
+	// "The curtain is too small to cover the statue."
+	0x42, 0x63, 0x47, 0xa2, 0x68, 0x43, 0xd1, 0x41, 0xbd, 0x00,
+	// "A red carpet leads between the entrance door and stairs t..."
+	0x51, 0x03, 0x72, 0x65, 0x64, 0x06, 0x63, 0x61, 0x72, 0x70, 0x65, 0x74, 0x90, 0x07, 0x62, 0x65,
+	0x74, 0x77, 0x65, 0x65, 0x6e, 0x41, 0x81, 0x5d, 0x45, 0x4f, 0x04, 0x74, 0x68, 0x61, 0x74, 0x53,
+	0x4e, 0x45, 0x8d, 0x42, 0x03, 0x6f, 0x69, 0x6c, 0x8e, 0x55, 0x41, 0x9d, 0x05, 0x64, 0x69, 0x6d,
+	0x6c, 0x79, 0x4c, 0x41, 0x61, 0x49, 0x07, 0x64, 0x61, 0x6e, 0x63, 0x69, 0x6e, 0x67, 0x08, 0x73,
+	0x68, 0x61, 0x64, 0x6f, 0x77, 0x73, 0x2e, 0x00,
+	// "The doors are made of old oak. Patterns of trees and fall..."
+	0x42, 0xd3, 0x50, 0x98, 0x48, 0x03, 0x6f, 0x6c, 0x64, 0x04, 0x6f, 0x61, 0x6b, 0x2e, 0x08, 0x50,
+	0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x73, 0x48, 0x05, 0x74, 0x72, 0x65, 0x65, 0x73, 0x45, 0x07,
+	0x66, 0x61, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x06, 0x6c, 0x65, 0x61, 0x76, 0x65, 0x73, 0x50, 0x06,
+	0x63, 0x61, 0x72, 0x76, 0x65, 0x64, 0x5f, 0x41, 0x06, 0x64, 0x6f, 0x6f, 0x72, 0x73, 0x2e, 0x00,
+	// "The wooden stairs go up as they wind around the wall, lea..."
+	0x42, 0x06, 0x77, 0x6f, 0x6f, 0x64, 0x65, 0x6e, 0x4f, 0x02, 0x67, 0x6f, 0x4e, 0x7d, 0x9c, 0x04,
+	0x77, 0x69, 0x6e, 0x64, 0xc0, 0x41, 0xe3, 0x07, 0x6c, 0x65, 0x61, 0x64, 0x69, 0x6e, 0x67, 0x43,
+	0x41, 0x74, 0x65, 0x00,
+	// "The stone stairs hug the wall as they descend into darkness."
+	0x42, 0xe0, 0x4f, 0x03, 0x68, 0x75, 0x67, 0x41, 0x9d, 0x7d, 0x9c, 0xb6, 0x5f, 0xaa, 0x00,
+	// "The lamps are still running; though, they have not been t..."
+	0x42, 0x8e, 0x50, 0x05, 0x73, 0x74, 0x69, 0x6c, 0x6c, 0x08, 0x72, 0x75, 0x6e, 0x6e, 0x69, 0x6e,
+	0x67, 0x3b, 0x07, 0x74, 0x68, 0x6f, 0x75, 0x67, 0x68, 0x2c, 0x9c, 0x69, 0x03, 0x6e, 0x6f, 0x74,
+	0x04, 0x62, 0x65, 0x65, 0x6e, 0x07, 0x74, 0x6f, 0x75, 0x63, 0x68, 0x65, 0x64, 0x7a, 0x44, 0xef,
+	0x05, 0x74, 0x69, 0x6d, 0x65, 0x2e, 0x00,
+	// "You take one of the lamps off the wall."
+	0x46, 0x56, 0x7c, 0x48, 0x41, 0x8e, 0xa1, 0x41, 0x05, 0x77, 0x61, 0x6c, 0x6c, 0x2e, 0x00,
+	// "You already have a lamp!"
+	0x46, 0x07, 0x61, 0x6c, 0x72, 0x65, 0x61, 0x64, 0x79, 0x69, 0x44, 0x05, 0x6c, 0x61, 0x6d, 0x70,
+	0x21, 0x00,
+};
+
+#define TEXT_ACTION_LOOK ((text_id)0)
+#define TEXT_ACTION_TAKE ((text_id)6)
+#define TEXT_ACTION_USE ((text_id)12)
+#define TEXT_ACTION_ITEM ((text_id)17)
+#define TEXT_ACTION_CONTINUE ((text_id)23)
+#define TEXT_ITEM_MASTER_KEY ((text_id)33)
+#define TEXT_ITEM_LAMP ((text_id)42)
+#define TEXT_ITEM_BROAD_SWORD ((text_id)48)
+#define TEXT_ITEM_BROKEN_KEY ((text_id)62)
+#define TEXT_ITEM_BLANK_KEY ((text_id)71)
+#define TEXT_ITEM_MODIFIED_CHEST_KEY ((text_id)79)
+#define TEXT_ITEM_SHEET ((text_id)90)
+#define TEXT_ITEM_COPIED_KEY ((text_id)99)
+#define TEXT_ITEM_CHEST_KEY ((text_id)108)
+#define TEXT_ITEM_ROPE ((text_id)117)
+#define TEXT_OBJECT_WATER ((text_id)123)
+#define TEXT_OBJECT_ROPE ((text_id)117)
+#define TEXT_OBJECT_CRYSTAL ((text_id)33)
+#define TEXT_OBJECT_KEY ((text_id)130)
+#define TEXT_OBJECT_STAIRS_UP ((text_id)132)
+#define TEXT_OBJECT_STAIRS_DOWN ((text_id)135)
+#define TEXT_OBJECT_BARRELS ((text_id)138)
+#define TEXT_OBJECT_WELL ((text_id)147)
+#define TEXT_OBJECT_LARGE_BAT ((text_id)149)
+#define TEXT_OBJECT_DARKNESS ((text_id)160)
+#define TEXT_OBJECT_PINK_VIAL ((text_id)170)
+#define TEXT_OBJECT_YELLOW_VIAL ((text_id)177)
+#define TEXT_OBJECT_VIAL ((text_id)186)
+#define TEXT_OBJECT_DOOR ((text_id)188)
+#define TEXT_OBJECT_CHEST ((text_id)194)
+#define TEXT_OBJECT_TABLE ((text_id)201)
+#define TEXT_OBJECT_CURTAIN ((text_id)90)
+#define TEXT_OBJECT_KEY_MACHINE ((text_id)208)
+#define TEXT_OBJECT_WINDOW ((text_id)218)
+#define TEXT_OBJECT_ANGEL_STATUE ((text_id)226)
+#define TEXT_OBJECT_SILVER_SWORD ((text_id)48)
+#define TEXT_OBJECT_ENTRANCE ((text_id)240)
+#define TEXT_OBJECT_LAMP ((text_id)42)
+#define TEXT_EMPTY ((text_id)250)
+#define TEXT_NOTHING_HAPPENS ((text_id)252)
+#define TEXT_NO_USEFUL_ITEMS ((text_id)270)
+#define TEXT_DOOR_SHUT_TIGHT ((text_id)291)
+#define TEXT_INTRO_DESCRIPTION ((text_id)317)
+#define TEXT_RESURRECT_DESCRIPTION ((text_id)438)
+#define TEXT_DRINK_PINK_VIAL ((text_id)486)
+#define TEXT_DRINK_YELLOW_VIAL ((text_id)551)
+#define TEXT_WIN_DESCRIPTION ((text_id)648)
+#define TEXT_WON_DESCRIPTION ((text_id)773)
+#define TEXT_F0_WELL_DESCRIPTION ((text_id)830)
+#define TEXT_F0_WELL_CRYSTAL_VISIBLE ((text_id)862)
+#define TEXT_F0_WELL_LOOK_WATER ((text_id)878)
+#define TEXT_F0_WELL_LOOK_ROPE ((text_id)899)
+#define TEXT_F0_WELL_LOOK_CRYSTAL ((text_id)917)
+#define TEXT_F0_WELL_LOOK_KEY ((text_id)934)
+#define TEXT_F0_WELL_NOTICE_KEY ((text_id)964)
+#define TEXT_F0_WELL_TAKE_CRYSTAL_KEY_FADES ((text_id)985)
+#define TEXT_F0_WELL_TAKE_CRYSTAL ((text_id)1016)
+#define TEXT_F0_WELL_TAKE_KEY ((text_id)1022)
+#define TEXT_F0_STORE_DESCRIPTION ((text_id)1028)
+#define TEXT_F0_LOOK_STAIRS_UP ((text_id)1079)
+#define TEXT_F0_STORE_LOOK_BARRELS ((text_id)1091)
+#define TEXT_F0_STORE_LOOK_WELL ((text_id)1109)
+#define TEXT_F0_STORE_LOOK_ROPE ((text_id)1118)
+#define TEXT_F0_STORE_NOTICE_ROPE ((text_id)1148)
+#define TEXT_F0_STORE_SHIMMER_IN_WATER ((text_id)1160)
+#define TEXT_F0_STORE_TAKE_ROPE ((text_id)1199)
+#define TEXT_F0_STORE_TIE_ROPE ((text_id)1210)
+#define TEXT_F0_STORE_WATER_STILL ((text_id)1221)
+#define TEXT_F0_BAT_DISTURBED ((text_id)1232)
+#define TEXT_F0_BAT_LOOK_BAT ((text_id)1318)
+#define TEXT_F0_BAT_KILLS_PLAYER ((text_id)1357)
+#define TEXT_F0_BAT_DIES ((text_id)1409)
+#define TEXT_F0_DARK_DESCRIPTION ((text_id)1551)
+#define TEXT_F0_DARK_LOOK_DARKNESS ((text_id)1597)
+#define TEXT_F4_CHEST_DESCRIPTION ((text_id)1619)
+#define TEXT_F4_CHEST_TWO_VIALS ((text_id)1676)
+#define TEXT_F4_CHEST_ONE_VIAL ((text_id)1715)
+#define TEXT_F4_CHEST_LOOK_PINK_VIAL ((text_id)1722)
+#define TEXT_F4_CHEST_LOOK_YELLOW_VIAL ((text_id)1730)
+#define TEXT_F4_HALL_DESCRIPTION ((text_id)1738)
+#define TEXT_F4_HALL_LOOK_CHEST ((text_id)1792)
+#define TEXT_F4_HALL_LOOK_STAIRS_DOWN ((text_id)1851)
+#define TEXT_F4_HALL_TAKE_CHEST ((text_id)1860)
+#define TEXT_F4_DOOR_UNLOCKED ((text_id)1922)
+#define TEXT_F4_LOCKED_DESCRIPTION ((text_id)2007)
+#define TEXT_F4_LOCKED_OBJECT_STAIRS_DOWN ((text_id)2049)
+#define TEXT_F4_LOCKED_LOOK_STAIRS_DOWN ((text_id)2056)
+#define TEXT_F4_LOCKED_LOOK_DOOR ((text_id)2065)
+#define TEXT_F3_HALL_DESCRIPTION ((text_id)2137)
+#define TEXT_F3_HALL_KEY_MACHINE_VISIBLE ((text_id)2202)
+#define TEXT_F3_HALL_CURTAIN_VISIBLE ((text_id)2222)
+#define TEXT_F3_HALL_LOOK_TABLE_WITH_KEY ((text_id)2244)
+#define TEXT_F3_HALL_LOOK_TABLE ((text_id)2280)
+#define TEXT_F3_HALL_LOOK_CURTAIN ((text_id)2296)
+#define TEXT_F3_HALL_LOOK_KEY_MACHINE ((text_id)2342)
+#define TEXT_F3_HALL_LOOK_STAIRS_UP ((text_id)2376)
+#define TEXT_F3_HALL_LOOK_STAIRS_DOWN ((text_id)2389)
+#define TEXT_F3_HALL_LOOK_KEY ((text_id)2407)
+#define TEXT_F3_HALL_MACHINE_MAKES_KEY ((text_id)2452)
+#define TEXT_F3_HALL_MACHINE_INSTRUCTIONS ((text_id)2471)
+#define TEXT_F3_HALL_TAKE_CURTAIN ((text_id)2511)
+#define TEXT_F3_HALL_TAKE_KEY ((text_id)2540)
+#define TEXT_F3_HALL_KEY_NEEDS_NO_COPY ((text_id)2552)
+#define TEXT_F3_HALL_PLACE_BROKEN_KEY ((text_id)2577)
+#define TEXT_F3_HALL_PLACE_COPPER_KEY ((text_id)2588)
+#define TEXT_F3_HALL_PLACE_BLANK_KEY ((text_id)2599)
+#define TEXT_F2_HALL_DESCRIPTION ((text_id)2610)
+#define TEXT_F2_HALL_SWORD_ON_GROUND ((text_id)2675)
+#define TEXT_F2_HALL_LOOK_WINDOW ((text_id)2693)
+#define TEXT_F2_HALL_LOOK_STATUE ((text_id)2737)
+#define TEXT_F2_HALL_LOOK_STATUE_CHANGED ((text_id)2785)
+#define TEXT_F2_HALL_LOOK_STAIRS_UP ((text_id)2828)
+#define TEXT_F2_HALL_LOOK_STAIRS_DOWN ((text_id)2837)
+#define TEXT_F2_HALL_LOOK_SWORD ((text_id)2854)
+#define TEXT_F2_HALL_LOOK_SWORD_ON_FLOOR ((text_id)2890)
+#define TEXT_F2_HALL_TAKE_SWORD ((text_id)2980)
+#define TEXT_F2_HALL_SWORD_STUCK ((text_id)3017)
+#define TEXT_F2_HALL_TAKE_KEY ((text_id)3055)
+#define TEXT_F2_HALL_COVER_WINDOW ((text_id)3083)
+#define TEXT_F2_HALL_CURTAIN_TOO_SMALL ((text_id)3179)
+#define TEXT_F1_HALL_DESCRIPTION ((text_id)3189)
+#define TEXT_F1_HALL_LOOK_ENTRANCE ((text_id)3261)
+#define TEXT_F1_HALL_LOOK_STAIRS_UP ((text_id)3325)
+#define TEXT_F1_HALL_LOOK_STAIRS_DOWN ((text_id)3361)
+#define TEXT_F1_HALL_LOOK_LAMP ((text_id)3376)
+#define TEXT_F1_HALL_TAKE_LAMP ((text_id)3431)
+#define TEXT_F1_HALL_HAVE_LAMP ((text_id)3446)
+
+#ifdef DARK_TOWER_TEXT_NAMES
+// Every text by name, for tools built on the host.
+struct text_name_type
+{
+	const char *name;
+	text_id text;
+};
+
+#define TEXT_NAME_COUNT 127
+
+const text_name_type text_names[TEXT_NAME_COUNT] =
+	{ { "action_look", TEXT_ACTION_LOOK }
+	, { "action_take", TEXT_ACTION_TAKE }
+	, { "action_use", TEXT_ACTION_USE }
+	, { "action_item", TEXT_ACTION_ITEM }
+	, { "action_continue", TEXT_ACTION_CONTINUE }
+	, { "item_master_key", TEXT_ITEM_MASTER_KEY }
+	, { "item_lamp", TEXT_ITEM_LAMP }
+	, { "item_broad_sword", TEXT_ITEM_BROAD_SWORD }
+	, { "item_broken_key", TEXT_ITEM_BROKEN_KEY }
+	, { "item_blank_key", TEXT_ITEM_BLANK_KEY }
+	, { "item_modified_chest_key", TEXT_ITEM_MODIFIED_CHEST_KEY }
+	, { "item_sheet", TEXT_ITEM_SHEET }
+	, { "item_copied_key", TEXT_ITEM_COPIED_KEY }
+	, { "item_chest_key", TEXT_ITEM_CHEST_KEY }
+	, { "item_rope", TEXT_ITEM_ROPE }
+	, { "object_water", TEXT_OBJECT_WATER }
+	, { "object_rope", TEXT_OBJECT_ROPE }
+	, { "object_crystal", TEXT_OBJECT_CRYSTAL }
+	, { "object_key", TEXT_OBJECT_KEY }
+	, { "object_stairs_up", TEXT_OBJECT_STAIRS_UP }
+	, { "object_stairs_down", TEXT_OBJECT_STAIRS_DOWN }
+	, { "object_barrels", TEXT_OBJECT_BARRELS }
+	, { "object_well", TEXT_OBJECT_WELL }
+	, { "object_large_bat", TEXT_OBJECT_LARGE_BAT }
+	, { "object_darkness", TEXT_OBJECT_DARKNESS }
+	, { "object_pink_vial", TEXT_OBJECT_PINK_VIAL }
+	, { "object_yellow_vial", TEXT_OBJECT_YELLOW_VIAL }
+	, { "object_vial", TEXT_OBJECT_VIAL }
+	, { "object_door", TEXT_OBJECT_DOOR }
+	, { "object_chest", TEXT_OBJECT_CHEST }
+	, { "object_table", TEXT_OBJECT_TABLE }
+	, { "object_curtain", TEXT_OBJECT_CURTAIN }
+	, { "object_key_machine", TEXT_OBJECT_KEY_MACHINE }
+	, { "object_window", TEXT_OBJECT_WINDOW }
+	, { "object_angel_statue", TEXT_OBJECT_ANGEL_STATUE }
+	, { "object_silver_sword", TEXT_OBJECT_SILVER_SWORD }
+	, { "object_entrance", TEXT_OBJECT_ENTRANCE }
+	, { "object_lamp", TEXT_OBJECT_LAMP }
+	, { "empty", TEXT_EMPTY }
+	, { "nothing_happens", TEXT_NOTHING_HAPPENS }
+	, { "no_useful_items", TEXT_NO_USEFUL_ITEMS }
+	, { "door_shut_tight", TEXT_DOOR_SHUT_TIGHT }
+	, { "intro_description", TEXT_INTRO_DESCRIPTION }
+	, { "resurrect_description", TEXT_RESURRECT_DESCRIPTION }
+	, { "drink_pink_vial", TEXT_DRINK_PINK_VIAL }
+	, { "drink_yellow_vial", TEXT_DRINK_YELLOW_VIAL }
+	, { "win_description", TEXT_WIN_DESCRIPTION }
+	, { "won_description", TEXT_WON_DESCRIPTION }
+	, { "f0_well_description", TEXT_F0_WELL_DESCRIPTION }
+	, { "f0_well_crystal_visible", TEXT_F0_WELL_CRYSTAL_VISIBLE }
+	, { "f0_well_look_water", TEXT_F0_WELL_LOOK_WATER }
+	, { "f0_well_look_rope", TEXT_F0_WELL_LOOK_ROPE }
+	, { "f0_well_look_crystal", TEXT_F0_WELL_LOOK_CRYSTAL }
+	, { "f0_well_look_key", TEXT_F0_WELL_LOOK_KEY }
+	, { "f0_well_notice_key", TEXT_F0_WELL_NOTICE_KEY }
+	, { "f0_well_take_crystal_key_fades", TEXT_F0_WELL_TAKE_CRYSTAL_KEY_FADES }
+	, { "f0_well_take_crystal", TEXT_F0_WELL_TAKE_CRYSTAL }
+	, { "f0_well_take_key", TEXT_F0_WELL_TAKE_KEY }
+	, { "f0_store_description", TEXT_F0_STORE_DESCRIPTION }
+	, { "f0_look_stairs_up", TEXT_F0_LOOK_STAIRS_UP }
+	, { "f0_store_look_barrels", TEXT_F0_STORE_LOOK_BARRELS }
+	, { "f0_store_look_well", TEXT_F0_STORE_LOOK_WELL }
+	, { "f0_store_look_rope", TEXT_F0_STORE_LOOK_ROPE }
+	, { "f0_store_notice_rope", TEXT_F0_STORE_NOTICE_ROPE }
+	, { "f0_store_shimmer_in_water", TEXT_F0_STORE_SHIMMER_IN_WATER }
+	, { "f0_store_take_rope", TEXT_F0_STORE_TAKE_ROPE }
+	, { "f0_store_tie_rope", TEXT_F0_STORE_TIE_ROPE }
+	, { "f0_store_water_still", TEXT_F0_STORE_WATER_STILL }
+	, { "f0_bat_disturbed", TEXT_F0_BAT_DISTURBED }
+	, { "f0_bat_look_bat", TEXT_F0_BAT_LOOK_BAT }
+	, { "f0_bat_kills_player", TEXT_F0_BAT_KILLS_PLAYER }
+	, { "f0_bat_dies", TEXT_F0_BAT_DIES }
+	, { "f0_dark_description", TEXT_F0_DARK_DESCRIPTION }
+	, { "f0_dark_look_darkness", TEXT_F0_DARK_LOOK_DARKNESS }
+	, { "f4_chest_description", TEXT_F4_CHEST_DESCRIPTION }
+	, { "f4_chest_two_vials", TEXT_F4_CHEST_TWO_VIALS }
+	, { "f4_chest_one_vial", TEXT_F4_CHEST_ONE_VIAL }
+	, { "f4_chest_look_pink_vial", TEXT_F4_CHEST_LOOK_PINK_VIAL }
+	, { "f4_chest_look_yellow_vial", TEXT_F4_CHEST_LOOK_YELLOW_VIAL }
+	, { "f4_hall_description", TEXT_F4_HALL_DESCRIPTION }
+	, { "f4_hall_look_chest", TEXT_F4_HALL_LOOK_CHEST }
+	, { "f4_hall_look_stairs_down", TEXT_F4_HALL_LOOK_STAIRS_DOWN }
+	, { "f4_hall_take_chest", TEXT_F4_HALL_TAKE_CHEST }
+	, { "f4_door_unlocked", TEXT_F4_DOOR_UNLOCKED }
+	, { "f4_locked_description", TEXT_F4_LOCKED_DESCRIPTION }
+	, { "f4_locked_object_stairs_down", TEXT_F4_LOCKED_OBJECT_STAIRS_DOWN }
+	, { "f4_locked_look_stairs_down", TEXT_F4_LOCKED_LOOK_STAIRS_DOWN }
+	, { "f4_locked_look_door", TEXT_F4_LOCKED_LOOK_DOOR }
+	, { "f3_hall_description", TEXT_F3_HALL_DESCRIPTION }
+	, { "f3_hall_key_machine_visible", TEXT_F3_HALL_KEY_MACHINE_VISIBLE }
+	, { "f3_hall_curtain_visible", TEXT_F3_HALL_CURTAIN_VISIBLE }
+	, { "f3_hall_look_table_with_key", TEXT_F3_HALL_LOOK_TABLE_WITH_KEY }
+	, { "f3_hall_look_table", TEXT_F3_HALL_LOOK_TABLE }
+	, { "f3_hall_look_curtain", TEXT_F3_HALL_LOOK_CURTAIN }
+	, { "f3_hall_look_key_machine", TEXT_F3_HALL_LOOK_KEY_MACHINE }
+	, { "f3_hall_look_stairs_up", TEXT_F3_HALL_LOOK_STAIRS_UP }
+	, { "f3_hall_look_stairs_down", TEXT_F3_HALL_LOOK_STAIRS_DOWN }
+	, { "f3_hall_look_key", TEXT_F3_HALL_LOOK_KEY }
+	, { "f3_hall_machine_makes_key", TEXT_F3_HALL_MACHINE_MAKES_KEY }
+	, { "f3_hall_machine_instructions", TEXT_F3_HALL_MACHINE_INSTRUCTIONS }
+	, { "f3_hall_take_curtain", TEXT_F3_HALL_TAKE_CURTAIN }
+	, { "f3_hall_take_key", TEXT_F3_HALL_TAKE_KEY }
+	, { "f3_hall_key_needs_no_copy", TEXT_F3_HALL_KEY_NEEDS_NO_COPY }
+	, { "f3_hall_place_broken_key", TEXT_F3_HALL_PLACE_BROKEN_KEY }
+	, { "f3_hall_place_copper_key", TEXT_F3_HALL_PLACE_COPPER_KEY }
+	, { "f3_hall_place_blank_key", TEXT_F3_HALL_PLACE_BLANK_KEY }
+	, { "f2_hall_description", TEXT_F2_HALL_DESCRIPTION }
+	, { "f2_hall_sword_on_ground", TEXT_F2_HALL_SWORD_ON_GROUND }
+	, { "f2_hall_look_window", TEXT_F2_HALL_LOOK_WINDOW }
+	, { "f2_hall_look_statue", TEXT_F2_HALL_LOOK_STATUE }
+	, { "f2_hall_look_statue_changed", TEXT_F2_HALL_LOOK_STATUE_CHANGED }
+	, { "f2_hall_look_stairs_up", TEXT_F2_HALL_LOOK_STAIRS_UP }
+	, { "f2_hall_look_stairs_down", TEXT_F2_HALL_LOOK_STAIRS_DOWN }
+	, { "f2_hall_look_sword", TEXT_F2_HALL_LOOK_SWORD }
+	, { "f2_hall_look_sword_on_floor", TEXT_F2_HALL_LOOK_SWORD_ON_FLOOR }
+	, { "f2_hall_take_sword", TEXT_F2_HALL_TAKE_SWORD }
+	, { "f2_hall_sword_stuck", TEXT_F2_HALL_SWORD_STUCK }
+	, { "f2_hall_take_key", TEXT_F2_HALL_TAKE_KEY }
+	, { "f2_hall_cover_window", TEXT_F2_HALL_COVER_WINDOW }
+	, { "f2_hall_curtain_too_small", TEXT_F2_HALL_CURTAIN_TOO_SMALL }
+	, { "f1_hall_description", TEXT_F1_HALL_DESCRIPTION }
+	, { "f1_hall_look_entrance", TEXT_F1_HALL_LOOK_ENTRANCE }
+	, { "f1_hall_look_stairs_up", TEXT_F1_HALL_LOOK_STAIRS_UP }
+	, { "f1_hall_look_stairs_down", TEXT_F1_HALL_LOOK_STAIRS_DOWN }
+	, { "f1_hall_look_lamp", TEXT_F1_HALL_LOOK_LAMP }
+	, { "f1_hall_take_lamp", TEXT_F1_HALL_TAKE_LAMP }
+	, { "f1_hall_have_lamp", TEXT_F1_HALL_HAVE_LAMP }
+	};
+#endif
+
+#endif
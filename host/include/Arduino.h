@@ -0,0 +1,103 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Minimal stand-in for the Arduino core so that DarkTower.cpp compiles
+// unchanged on a desktop machine. Flash and SRAM share one address space on
+// the host, so the PROGMEM helpers collapse onto their plain C equivalents.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// The Gamebuino's ATmega328P runs at 16 MHz.
+#define F_CPU 16000000UL
+
+#define PROGMEM
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+
+// On AVR a pointer fits in a word, and the sketch reads pointer tables with
+// pgm_read_word. Returning the element type keeps that working on 64-bit hosts.
+template <typename T> inline T host_pgm_read_word(const T *addr) { return *addr; }
+inline uint16_t host_pgm_read_word(const void *addr) { return *(const uint16_t *)addr; }
+#define pgm_read_word(addr) host_pgm_read_word(addr)
+
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcat_P strcat
+#define strncat_P strncat
+#define strcmp_P strcmp
+#define memcpy_P memcpy
+
+#define DEC 10
+#define HEX 16
+
+unsigned long millis();
+unsigned long micros();
+
+class Print {
+public:
+	virtual ~Print() { }
+	virtual size_t write(uint8_t c) = 0;
+
+	size_t write(const uint8_t *buffer, size_t size);
+	size_t write(const char *str) { return write((const uint8_t *)str, strlen(str)); }
+
+	size_t print(const __FlashStringHelper *str) { return write((const char *)str); }
+	size_t print(const char *str) { return write(str); }
+	size_t print(char c) { return write((uint8_t)c); }
+	size_t print(int n, int base = DEC) { return print((long)n, base); }
+	size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+	size_t print(long n, int base = DEC);
+	size_t print(unsigned long n, int base = DEC);
+
+	size_t println() { return write('\n'); }
+	template <typename T> size_t println(T value) { return print(value) + println(); }
+	template <typename T> size_t println(T value, int base) { return print(value, base) + println(); }
+};
+
+// Input comes from host_send_serial_input(), into a receive buffer the size
+// of the device's.
+#define SERIAL_RX_BUFFER_SIZE 64
+
+class HardwareSerial : public Print {
+public:
+	void begin(unsigned long baud) { (void)baud; }
+	int available();
+	int read();
+	size_t write(uint8_t c);
+	using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif
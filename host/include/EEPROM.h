@@ -0,0 +1,39 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Stand-in for the Arduino EEPROM library: the ATmega328P's 1KB of EEPROM,
+// held in memory and erased (all 0xff) at start up.
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+#define E2END 0x3ff
+
+class EEPROMClass {
+public:
+	uint8_t read(int idx);
+	void write(int idx, uint8_t val);
+	void update(int idx, uint8_t val) { if (read(idx) != val) write(idx, val); }
+	uint16_t length() { return E2END + 1; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Stand-in for the parts of the Gamebuino Classic 0.5.2 library used by the
+// game. Names, constants and frame semantics follow the real library; the
+// LCD is replaced by an in-memory PCD8544 framebuffer and the buttons are
+// fed from gamebuino_host.h.
+
+#ifndef HOST_GAMEBUINO_H
+#define HOST_GAMEBUINO_H
+
+#include <Arduino.h>
+
+#define LCDWIDTH 84
+#define LCDHEIGHT 48
+
+#define WHITE 0
+#define BLACK 1
+#define INVERT 2
+#define GRAY 3
+
+#define BTN_LEFT 0
+#define BTN_UP 1
+#define BTN_RIGHT 2
+#define BTN_DOWN 3
+#define BTN_A 4
+#define BTN_B 5
+#define BTN_C 6
+#define NUM_BTN 7
+
+#define NUM_FRAMES_PER_SECOND 20
+
+class Display : public Print {
+public:
+	Display();
+
+	void setFont(const uint8_t *f);
+	void clear();
+	void update();
+
+	uint8_t *getBuffer() { return _displayBuffer; }
+
+	void setColor(int8_t c) { color = bgcolor = c; }
+	void setColor(int8_t c, int8_t bg) { color = c; bgcolor = bg; }
+
+	void drawPixel(int8_t x, int8_t y);
+	uint8_t getPixel(int8_t x, int8_t y);
+	void drawFastVLine(int8_t x, int8_t y, int8_t h);
+	void drawFastHLine(int8_t x, int8_t y, int8_t w);
+	void drawRect(int8_t x, int8_t y, int8_t w, int8_t h);
+	void fillRect(int8_t x, int8_t y, int8_t w, int8_t h);
+	void drawRoundRect(int8_t x0, int8_t y0, int8_t w, int8_t h, int8_t radius);
+	void drawChar(int8_t x, int8_t y, unsigned char c, uint8_t size);
+
+	size_t write(uint8_t c);
+	using Print::write;
+
+	int8_t cursorX, cursorY;
+	uint8_t fontWidth, fontHeight;
+	uint8_t fontSize;
+	boolean textWrap;
+	boolean persistence;
+	int8_t color, bgcolor;
+
+private:
+	uint8_t _displayBuffer[LCDWIDTH * LCDHEIGHT / 8];
+	const uint8_t *font;
+
+	void drawCircleHelper(int8_t x0, int8_t y0, int8_t r, uint8_t cornername);
+};
+
+class Buttons {
+public:
+	Buttons();
+
+	void update();
+	boolean pressed(uint8_t button);
+	boolean released(uint8_t button);
+	boolean held(uint8_t button, uint8_t time);
+	boolean repeat(uint8_t button, uint8_t period);
+	uint8_t timeHeld(uint8_t button);
+
+	uint8_t states[NUM_BTN];
+};
+
+class Backlight {
+public:
+	Backlight() : automatic( true ), level( 255 ) { }
+
+	void set(uint8_t value) { level = value; }
+	void update() { }
+
+	boolean automatic;
+	uint8_t level;
+};
+
+class Gamebuino {
+public:
+	Gamebuino();
+
+	Buttons buttons;
+	Backlight backlight;
+	Display display;
+
+	void begin();
+	void titleScreen(const __FlashStringHelper *name);
+	void titleScreen();
+	boolean update();
+	void setFrameRate(uint8_t fps);
+	uint8_t getCpuLoad();
+	uint16_t getFreeRam();
+	void popup(const __FlashStringHelper *text, uint8_t duration) { (void)text; (void)duration; }
+
+	uint32_t frameCount;
+	uint8_t frameRate;
+	uint16_t frameDurationMicros;
+
+private:
+	uint8_t timePerFrame;
+	boolean frameInProgress;
+};
+
+#endif
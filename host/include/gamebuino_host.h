@@ -0,0 +1,64 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host-only controls for the Gamebuino shim. These have no counterpart on the
+// device; drivers use them to feed input and observe frames.
+
+#ifndef HOST_GAMEBUINO_HOST_H
+#define HOST_GAMEBUINO_HOST_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Bit n set means button n (BTN_LEFT ... BTN_C) is held for the next frame.
+void host_set_buttons(uint8_t held_buttons);
+uint8_t host_get_buttons();
+
+// Called with the framebuffer each time the display would be sent to the LCD.
+typedef void (*host_frame_sent_callback)(const uint8_t *display_buffer);
+void host_set_frame_sent_callback(host_frame_sent_callback callback);
+
+// Serial output is discarded unless a stream is given.
+void host_set_serial_output(FILE *stream);
+
+// Queues bytes for the sketch to read from Serial. As on the device, bytes
+// that do not fit in the receive buffer are lost.
+void host_send_serial_input(const char *input);
+
+// The number of EEPROM cells written so far, each of which wears the device's
+// EEPROM a little.
+uint32_t host_get_eeprom_writes();
+
+// The host's own clock, counted in the device's CPU cycles, for profiling.
+// Unlike millis(), this is real time.
+uint32_t host_get_cycles();
+
+// Runs function on a stack of its own, painted with a pattern first, so that
+// the stack used and the headroom left on it can be reported later, as the
+// device's memory report does with the free RAM it paints at boot. Both are 0
+// until function has been run.
+void host_run_on_painted_stack(void (*function)());
+uint32_t host_get_stack_used();
+uint32_t host_get_stack_headroom();
+
+// The host build's own initialised data, bss and heap in use, in bytes.
+uint32_t host_get_data_size();
+uint32_t host_get_bss_size();
+uint32_t host_get_heap_size();
+
+#endif
@@ -0,0 +1,539 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <Gamebuino.h>
+#include <EEPROM.h>
+#include <gamebuino_host.h>
+
+#include <chrono>
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+extern const byte font5x7[];
+extern const byte font3x5[];
+
+// ------------------------------------------------
+// Host state
+// ------------------------------------------------
+
+// Time is virtual: it advances by one frame period per frame so that runs are
+// repeatable and are not throttled to the device's frame rate.
+static unsigned long host_clock_millis = 0;
+static uint8_t host_buttons_held = 0;
+static host_frame_sent_callback host_frame_sent = NULL;
+static FILE *host_serial_output = NULL;
+static uint8_t host_serial_input[SERIAL_RX_BUFFER_SIZE];
+static uint8_t host_serial_input_head = 0;
+static uint8_t host_serial_input_count = 0;
+static uint8_t host_eeprom[E2END + 1];
+static bool host_eeprom_erased = false;
+static uint32_t host_eeprom_writes = 0;
+
+void host_set_buttons(uint8_t held_buttons){
+	host_buttons_held = held_buttons;
+}
+
+uint8_t host_get_buttons(){
+	return host_buttons_held;
+}
+
+void host_set_frame_sent_callback(host_frame_sent_callback callback){
+	host_frame_sent = callback;
+}
+
+void host_set_serial_output(FILE *stream){
+	host_serial_output = stream;
+}
+
+void host_send_serial_input(const char *input){
+	for (; *input != '\0' && host_serial_input_count < SERIAL_RX_BUFFER_SIZE; input++){
+		host_serial_input[(host_serial_input_head + host_serial_input_count) % SERIAL_RX_BUFFER_SIZE] = *input;
+		host_serial_input_count++;
+	}
+}
+
+uint32_t host_get_eeprom_writes(){
+	return host_eeprom_writes;
+}
+
+uint32_t host_get_cycles(){
+	std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now().time_since_epoch();
+	return elapsed.count() * (F_CPU / 1000000UL) / 1000;
+}
+
+#define HOST_STACK_SIZE (256 * 1024)
+#define HOST_STACK_CANARY 0xc5
+
+// Mapped on its own, so that it counts towards none of the data, bss or heap.
+static uint8_t *host_stack = NULL;
+
+void host_run_on_painted_stack(void (*function)()){
+	ucontext_t caller;
+	ucontext_t painted;
+
+	if (host_stack == NULL){
+		void *mapped = mmap(NULL, HOST_STACK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapped == MAP_FAILED){
+			perror("mmap");
+			exit(2);
+		}
+		host_stack = (uint8_t*)mapped;
+	}
+	memset(host_stack, HOST_STACK_CANARY, HOST_STACK_SIZE);
+
+	getcontext(&painted);
+	painted.uc_stack.ss_sp = host_stack;
+	painted.uc_stack.ss_size = HOST_STACK_SIZE;
+	painted.uc_link = &caller;
+	makecontext(&painted, function, 0);
+	swapcontext(&caller, &painted);
+}
+
+// The stack grows down from the end of the region, so the untouched bytes are
+// at its start.
+uint32_t host_get_stack_headroom(){
+	if (host_stack == NULL)
+		return 0;
+
+	uint32_t untouched = 0;
+	while (untouched < HOST_STACK_SIZE && host_stack[untouched] == HOST_STACK_CANARY)
+		untouched++;
+	return untouched;
+}
+
+uint32_t host_get_stack_used(){
+	return host_stack != NULL ? HOST_STACK_SIZE - host_get_stack_headroom() : 0;
+}
+
+// Set by the linker around the program's own initialised data and bss.
+extern "C" char __data_start[];
+extern "C" char edata[];
+extern "C" char __bss_start[];
+extern "C" char end[];
+
+uint32_t host_get_data_size(){
+	return edata - __data_start;
+}
+
+uint32_t host_get_bss_size(){
+	return end - __bss_start;
+}
+
+uint32_t host_get_heap_size(){
+	return mallinfo2().uordblks;
+}
+
+unsigned long millis(){
+	return host_clock_millis;
+}
+
+unsigned long micros(){
+	return host_clock_millis * 1000UL;
+}
+
+// ------------------------------------------------
+// Arduino core
+// ------------------------------------------------
+
+HardwareSerial Serial;
+
+size_t Print::write(const uint8_t *buffer, size_t size){
+	size_t written = 0;
+	while (size--)
+		written += write(*buffer++);
+	return written;
+}
+
+size_t Print::print(long n, int base){
+	if (n < 0 && base == DEC)
+		return print('-') + print((unsigned long)-n, base);
+	return print((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base){
+	char digits[8 * sizeof(long) + 1];
+	char *cur_digit = &digits[sizeof(digits) - 1];
+	*cur_digit = '\0';
+
+	do {
+		uint8_t digit = n % base;
+		*--cur_digit = digit < 10 ? '0' + digit : 'A' + digit - 10;
+		n /= base;
+	} while (n);
+
+	return write(cur_digit);
+}
+
+int HardwareSerial::available(){
+	return host_serial_input_count;
+}
+
+int HardwareSerial::read(){
+	if (host_serial_input_count == 0)
+		return -1;
+
+	uint8_t c = host_serial_input[host_serial_input_head];
+	host_serial_input_head = (host_serial_input_head + 1) % SERIAL_RX_BUFFER_SIZE;
+	host_serial_input_count--;
+	return c;
+}
+
+size_t HardwareSerial::write(uint8_t c){
+	if (host_serial_output != NULL)
+		fputc(c, host_serial_output);
+	return 1;
+}
+
+// ------------------------------------------------
+// EEPROM
+// ------------------------------------------------
+
+EEPROMClass EEPROM;
+
+static void erase_host_eeprom_once(){
+	if (!host_eeprom_erased){
+		memset(host_eeprom, 0xff, sizeof(host_eeprom));
+		host_eeprom_erased = true;
+	}
+}
+
+uint8_t EEPROMClass::read(int idx){
+	erase_host_eeprom_once();
+	return host_eeprom[idx];
+}
+
+void EEPROMClass::write(int idx, uint8_t val){
+	erase_host_eeprom_once();
+	host_eeprom[idx] = val;
+	host_eeprom_writes++;
+}
+
+// ------------------------------------------------
+// Display
+// ------------------------------------------------
+
+Display::Display()
+: cursorX( 0 )
+, cursorY( 0 )
+, fontWidth( 0 )
+, fontHeight( 0 )
+, fontSize( 1 )
+, textWrap( true )
+, persistence( false )
+, color( BLACK )
+, bgcolor( WHITE )
+, font( NULL )
+{
+	memset(_displayBuffer, 0, sizeof(_displayBuffer));
+	setFont(font5x7);
+}
+
+void Display::setFont(const uint8_t *f){
+	font = f;
+	fontWidth = pgm_read_byte(font) + 1;
+	fontHeight = pgm_read_byte(font + 1) + 1;
+	font += 2;
+}
+
+void Display::clear(){
+	memset(_displayBuffer, 0, sizeof(_displayBuffer));
+	cursorX = cursorY = 0;
+}
+
+void Display::update(){
+	if (host_frame_sent != NULL)
+		host_frame_sent(_displayBuffer);
+}
+
+void Display::drawPixel(int8_t x, int8_t y){
+	if ((x < 0) || (x >= LCDWIDTH) || (y < 0) || (y >= LCDHEIGHT))
+		return;
+
+	uint8_t *cell = &_displayBuffer[x + (y / 8) * LCDWIDTH];
+	uint8_t bit = 1 << (y % 8);
+
+	switch (color){
+	case BLACK:
+		*cell |= bit;
+		break;
+	case WHITE:
+		*cell &= ~bit;
+		break;
+	case INVERT:
+		*cell ^= bit;
+		break;
+	case GRAY:
+		if ((x + y) & 1)
+			*cell |= bit;
+		else
+			*cell &= ~bit;
+		break;
+	}
+}
+
+uint8_t Display::getPixel(int8_t x, int8_t y){
+	if ((x < 0) || (x >= LCDWIDTH) || (y < 0) || (y >= LCDHEIGHT))
+		return 0;
+	return (_displayBuffer[x + (y / 8) * LCDWIDTH] >> (y % 8)) & 0x1;
+}
+
+void Display::drawFastVLine(int8_t x, int8_t y, int8_t h){
+	for (int8_t i = 0; i < h; i++)
+		drawPixel(x, y + i);
+}
+
+void Display::drawFastHLine(int8_t x, int8_t y, int8_t w){
+	for (int8_t i = 0; i < w; i++)
+		drawPixel(x + i, y);
+}
+
+void Display::drawRect(int8_t x, int8_t y, int8_t w, int8_t h){
+	drawFastHLine(x, y, w);
+	drawFastHLine(x, y + h - 1, w);
+	drawFastVLine(x, y, h);
+	drawFastVLine(x + w - 1, y, h);
+}
+
+void Display::fillRect(int8_t x, int8_t y, int8_t w, int8_t h){
+	for (int8_t i = 0; i < h; i++)
+		drawFastHLine(x, y + i, w);
+}
+
+void Display::drawCircleHelper(int8_t x0, int8_t y0, int8_t r, uint8_t cornername){
+	int16_t f = 1 - r;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * r;
+	int16_t x = 0;
+	int16_t y = r;
+
+	while (x < y){
+		if (f >= 0){
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+		if (cornername & 0x4){
+			drawPixel(x0 + x, y0 + y);
+			drawPixel(x0 + y, y0 + x);
+		}
+		if (cornername & 0x2){
+			drawPixel(x0 + x, y0 - y);
+			drawPixel(x0 + y, y0 - x);
+		}
+		if (cornername & 0x8){
+			drawPixel(x0 - y, y0 + x);
+			drawPixel(x0 - x, y0 + y);
+		}
+		if (cornername & 0x1){
+			drawPixel(x0 - y, y0 - x);
+			drawPixel(x0 - x, y0 - y);
+		}
+	}
+}
+
+void Display::drawRoundRect(int8_t x, int8_t y, int8_t w, int8_t h, int8_t r){
+	drawFastHLine(x + r, y, w - 2 * r);
+	drawFastHLine(x + r, y + h - 1, w - 2 * r);
+	drawFastVLine(x, y + r, h - 2 * r);
+	drawFastVLine(x + w - 1, y + r, h - 2 * r);
+	drawCircleHelper(x + r, y + r, r, 1);
+	drawCircleHelper(x + w - r - 1, y + r, r, 2);
+	drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4);
+	drawCircleHelper(x + r, y + h - r - 1, r, 8);
+}
+
+void Display::drawChar(int8_t x, int8_t y, unsigned char c, uint8_t size){
+	int8_t tempcolor = color;
+
+	if ((x >= LCDWIDTH) || (y >= LCDHEIGHT) || ((x + fontWidth * size - 1) < 0) || ((y + fontHeight * size - 1) < 0))
+		return;
+	if (c & 0x80)
+		return;
+
+	for (int8_t i = 0; i < fontWidth; i++){
+		uint8_t line;
+		if (i == (fontWidth - 1))
+			line = 0x0;
+		else
+			line = pgm_read_byte(font + (c * (fontWidth - 1)) + i);
+
+		for (int8_t j = 0; j < fontHeight; j++){
+			if (line & 0x1){
+				color = tempcolor;
+				if (size == 1)
+					drawPixel(x + i, y + j);
+				else
+					fillRect(x + (i * size), y + (j * size), size, size);
+			}
+			else if (bgcolor != tempcolor){
+				color = bgcolor;
+				if (size == 1)
+					drawPixel(x + i, y + j);
+				else
+					fillRect(x + (i * size), y + (j * size), size, size);
+			}
+			line >>= 1;
+		}
+	}
+	color = tempcolor;
+}
+
+size_t Display::write(uint8_t c){
+	if (c == '\n'){
+		cursorY += fontSize * fontHeight;
+		cursorX = 0;
+	}
+	else if (c == '\r'){
+		// skip em
+	}
+	else {
+		drawChar(cursorX, cursorY, c, fontSize);
+		cursorX += fontSize * fontWidth;
+		if (textWrap && (cursorX > (LCDWIDTH - fontSize * fontWidth))){
+			cursorY += fontSize * fontHeight;
+			cursorX = 0;
+		}
+	}
+	return 1;
+}
+
+// ------------------------------------------------
+// Buttons
+// ------------------------------------------------
+
+Buttons::Buttons(){
+	memset(states, 0, sizeof(states));
+}
+
+void Buttons::update(){
+	for (uint8_t thisButton = 0; thisButton < NUM_BTN; thisButton++){
+		if (host_buttons_held & (1 << thisButton)){
+			states[thisButton]++;
+			if (states[thisButton] == 0xFF)
+				states[thisButton] = 0xFE;
+		}
+		else {
+			if (states[thisButton] == 0)
+				continue;
+			if (states[thisButton] == 0xFF)
+				states[thisButton] = 0;
+			else
+				states[thisButton] = 0xFF;
+		}
+	}
+}
+
+boolean Buttons::pressed(uint8_t button){
+	return states[button] == 1;
+}
+
+boolean Buttons::released(uint8_t button){
+	return states[button] == 0xFF;
+}
+
+boolean Buttons::held(uint8_t button, uint8_t time){
+	return states[button] == (time + 1);
+}
+
+boolean Buttons::repeat(uint8_t button, uint8_t period){
+	if (period <= 1){
+		if ((states[button] != 0xFF) && (states[button]))
+			return true;
+	}
+	else {
+		if ((states[button] != 0xFF) && ((states[button] % period) == 1))
+			return true;
+	}
+	return false;
+}
+
+uint8_t Buttons::timeHeld(uint8_t button){
+	if (states[button] != 0xFF)
+		return states[button];
+	return 0;
+}
+
+// ------------------------------------------------
+// Gamebuino
+// ------------------------------------------------
+
+Gamebuino::Gamebuino()
+: frameCount( 0 )
+, frameRate( NUM_FRAMES_PER_SECOND )
+, frameDurationMicros( 0 )
+, timePerFrame( 1000 / NUM_FRAMES_PER_SECOND )
+, frameInProgress( false )
+{ }
+
+void Gamebuino::begin(){
+	display.setFont(font5x7);
+	display.clear();
+}
+
+// The device waits here for the A button; headless runs go straight on, but
+// leave the display set up the way the real title screen does.
+void Gamebuino::titleScreen(const __FlashStringHelper *name){
+	(void)name;
+	display.setFont(font5x7);
+	display.fontSize = 1;
+	display.textWrap = false;
+	display.persistence = false;
+	display.setColor(BLACK);
+	display.clear();
+}
+
+void Gamebuino::titleScreen(){
+	titleScreen(NULL);
+}
+
+void Gamebuino::setFrameRate(uint8_t fps){
+	frameRate = fps;
+	timePerFrame = 1000 / fps;
+}
+
+uint8_t Gamebuino::getCpuLoad(){
+	return 0;
+}
+
+uint16_t Gamebuino::getFreeRam(){
+	return 0;
+}
+
+// The device returns false until the next frame is due, and sends and clears
+// the display on the first such call. Here the frame period is skipped, so a
+// call both finishes the previous frame and starts the next one.
+boolean Gamebuino::update(){
+	if (frameInProgress){
+		display.update();
+		if (!display.persistence)
+			display.clear();
+	}
+
+	host_clock_millis += timePerFrame;
+	frameCount++;
+	frameInProgress = true;
+
+	backlight.update();
+	buttons.update();
+	return true;
+}
@@ -0,0 +1,121 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Headless frame benchmark. The sketch is compiled into this translation unit
+// so the driver can run loop() under the host's virtual clock, as the replay
+// tool does, and time each frame exactly as the game runs it.
+//
+// usage: dark_tower_bench [frames_per_phase] [seed]
+
+#include "../../DarkTower.cpp"
+
+#include <gamebuino_host.h>
+
+#include "scripted_input.h"
+
+#include <chrono>
+#include <stdlib.h>
+
+typedef std::chrono::steady_clock bench_clock;
+
+struct frame_time_stats
+{
+	frame_time_stats()
+	: frames( 0 )
+	, total_ns( 0 )
+	, min_ns( UINT64_MAX )
+	, max_ns( 0 )
+	{ }
+
+	void add(uint64_t frame_ns){
+		frames++;
+		total_ns += frame_ns;
+		if (frame_ns < min_ns)
+			min_ns = frame_ns;
+		if (frame_ns > max_ns)
+			max_ns = frame_ns;
+	}
+
+	uint32_t frames;
+	uint64_t total_ns;
+	uint64_t min_ns;
+	uint64_t max_ns;
+};
+
+static uint64_t elapsed_ns(bench_clock::time_point start, bench_clock::time_point end){
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+static void boot_to_play(){
+	host_set_buttons(0);
+	setup();
+	while (game_state.state != GAME_STATE_ID_PLAY)
+		loop();
+}
+
+// Times each call of loop(), so the bench covers the whole frame: the
+// presenter, the frame governor and the recorder and profiler hooks.
+static frame_time_stats run_phase(uint32_t frames, scripted_input_type *input, uint64_t *phase_ns){
+	frame_time_stats stats;
+	bench_clock::time_point phase_start = bench_clock::now();
+
+	for (uint32_t i = 0; i < frames; i++){
+		host_set_buttons(input != NULL ? input->next_frame() : 0);
+		bench_clock::time_point start = bench_clock::now();
+		loop();
+		bench_clock::time_point end = bench_clock::now();
+		stats.add(elapsed_ns(start, end));
+	}
+
+	*phase_ns = elapsed_ns(phase_start, bench_clock::now());
+	return stats;
+}
+
+static void print_phase(const char *name, const frame_time_stats& stats, uint64_t phase_ns){
+	double frames_per_second = phase_ns ? stats.frames * 1e9 / phase_ns : 0.0;
+	double avg_ns = stats.frames ? (double)stats.total_ns / stats.frames : 0.0;
+
+	printf("%-8s %8u %12.0f %10.2f %10.2f %10.2f\n"
+		, name
+		, stats.frames
+		, frames_per_second
+		, stats.min_ns / 1000.0
+		, avg_ns / 1000.0
+		, stats.max_ns / 1000.0
+		);
+}
+
+int main(int argc, char **argv){
+	uint32_t frames = argc > 1 ? strtoul(argv[1], NULL, 10) : 20000;
+	uint32_t seed = argc > 2 ? strtoul(argv[2], NULL, 10) : 1;
+	uint64_t phase_ns;
+
+	boot_to_play();
+
+	printf("Dark Tower host benchmark: %u frames per phase, seed %u\n", frames, seed);
+	printf("%-8s %8s %12s %10s %10s %10s\n", "phase", "frames", "frames/s", "min us", "avg us", "max us");
+
+	frame_time_stats reading = run_phase(frames, NULL, &phase_ns);
+	print_phase("reading", reading, phase_ns);
+
+	scripted_input_type input(seed);
+	frame_time_stats playing = run_phase(frames, &input, &phase_ns);
+	print_phase("playing", playing, phase_ns);
+
+	return 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+// Glyph tables in the Gamebuino layout: width and height, then one byte per
+// column for every character code, least significant bit at the top. Only
+// the 7-bit range is provided; the shim draws nothing for codes above it.
+
+#include <Arduino.h>
+
+extern const byte font5x7[];
+extern const byte font3x5[];
+
+const byte font5x7[] PROGMEM = {
+	5, 7,
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x01
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x02
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x03
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x04
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x05
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x06
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x07
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x09
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x0A
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x0B
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x0C
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x0D
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x0E
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x0F
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x11
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x12
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x13
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x14
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x15
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x16
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x17
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x19
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x1A
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x1B
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x1C
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x1D
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x1E
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x1F
+	0x00, 0x00, 0x00, 0x00, 0x00, // ' '
+	0x00, 0x00, 0x5F, 0x00, 0x00, // '!'
+	0x00, 0x07, 0x00, 0x07, 0x00, // '"'
+	0x14, 0x7F, 0x14, 0x7F, 0x14, // '#'
+	0x24, 0x2A, 0x7F, 0x2A, 0x12, // '$'
+	0x23, 0x13, 0x08, 0x64, 0x62, // '%'
+	0x36, 0x49, 0x56, 0x20, 0x50, // '&'
+	0x00, 0x08, 0x07, 0x03, 0x00, // '\''
+	0x00, 0x1C, 0x22, 0x41, 0x00, // '('
+	0x00, 0x41, 0x22, 0x1C, 0x00, // ')'
+	0x2A, 0x1C, 0x7F, 0x1C, 0x2A, // '*'
+	0x08, 0x08, 0x3E, 0x08, 0x08, // '+'
+	0x00, 0x80, 0x70, 0x30, 0x00, // ','
+	0x08, 0x08, 0x08, 0x08, 0x08, // '-'
+	0x00, 0x00, 0x60, 0x60, 0x00, // '.'
+	0x20, 0x10, 0x08, 0x04, 0x02, // '/'
+	0x3E, 0x51, 0x49, 0x45, 0x3E, // '0'
+	0x00, 0x42, 0x7F, 0x40, 0x00, // '1'
+	0x72, 0x49, 0x49, 0x49, 0x46, // '2'
+	0x21, 0x41, 0x49, 0x4D, 0x33, // '3'
+	0x18, 0x14, 0x12, 0x7F, 0x10, // '4'
+	0x27, 0x45, 0x45, 0x45, 0x39, // '5'
+	0x3C, 0x4A, 0x49, 0x49, 0x31, // '6'
+	0x41, 0x21, 0x11, 0x09, 0x07, // '7'
+	0x36, 0x49, 0x49, 0x49, 0x36, // '8'
+	0x46, 0x49, 0x49, 0x29, 0x1E, // '9'
+	0x00, 0x00, 0x14, 0x00, 0x00, // ':'
+	0x00, 0x40, 0x34, 0x00, 0x00, // ';'
+	0x00, 0x08, 0x14, 0x22, 0x41, // '<'
+	0x14, 0x14, 0x14, 0x14, 0x14, // '='
+	0x00, 0x41, 0x22, 0x14, 0x08, // '>'
+	0x02, 0x01, 0x59, 0x09, 0x06, // '?'
+	0x3E, 0x41, 0x5D, 0x59, 0x4E, // '@'
+	0x7C, 0x12, 0x11, 0x12, 0x7C, // 'A'
+	0x7F, 0x49, 0x49, 0x49, 0x36, // 'B'
+	0x3E, 0x41, 0x41, 0x41, 0x22, // 'C'
+	0x7F, 0x41, 0x41, 0x41, 0x3E, // 'D'
+	0x7F, 0x49, 0x49, 0x49, 0x41, // 'E'
+	0x7F, 0x09, 0x09, 0x09, 0x01, // 'F'
+	0x3E, 0x41, 0x41, 0x51, 0x73, // 'G'
+	0x7F, 0x08, 0x08, 0x08, 0x7F, // 'H'
+	0x00, 0x41, 0x7F, 0x41, 0x00, // 'I'
+	0x20, 0x40, 0x41, 0x3F, 0x01, // 'J'
+	0x7F, 0x08, 0x14, 0x22, 0x41, // 'K'
+	0x7F, 0x40, 0x40, 0x40, 0x40, // 'L'
+	0x7F, 0x02, 0x1C, 0x02, 0x7F, // 'M'
+	0x7F, 0x04, 0x08, 0x10, 0x7F, // 'N'
+	0x3E, 0x41, 0x41, 0x41, 0x3E, // 'O'
+	0x7F, 0x09, 0x09, 0x09, 0x06, // 'P'
+	0x3E, 0x41, 0x51, 0x21, 0x5E, // 'Q'
+	0x7F, 0x09, 0x19, 0x29, 0x46, // 'R'
+	0x26, 0x49, 0x49, 0x49, 0x32, // 'S'
+	0x03, 0x01, 0x7F, 0x01, 0x03, // 'T'
+	0x3F, 0x40, 0x40, 0x40, 0x3F, // 'U'
+	0x1F, 0x20, 0x40, 0x20, 0x1F, // 'V'
+	0x3F, 0x40, 0x38, 0x40, 0x3F, // 'W'
+	0x63, 0x14, 0x08, 0x14, 0x63, // 'X'
+	0x03, 0x04, 0x78, 0x04, 0x03, // 'Y'
+	0x61, 0x59, 0x49, 0x4D, 0x43, // 'Z'
+	0x00, 0x7F, 0x41, 0x41, 0x41, // '['
+	0x02, 0x04, 0x08, 0x10, 0x20, // '\\'
+	0x00, 0x41, 0x41, 0x41, 0x7F, // ']'
+	0x04, 0x02, 0x01, 0x02, 0x04, // '^'
+	0x40, 0x40, 0x40, 0x40, 0x40, // '_'
+	0x00, 0x03, 0x07, 0x08, 0x00, // '`'
+	0x20, 0x54, 0x54, 0x78, 0x40, // 'a'
+	0x7F, 0x28, 0x44, 0x44, 0x38, // 'b'
+	0x38, 0x44, 0x44, 0x44, 0x28, // 'c'
+	0x38, 0x44, 0x44, 0x28, 0x7F, // 'd'
+	0x38, 0x54, 0x54, 0x54, 0x18, // 'e'
+	0x00, 0x08, 0x7E, 0x09, 0x02, // 'f'
+	0x18, 0xA4, 0xA4, 0x9C, 0x78, // 'g'
+	0x7F, 0x08, 0x04, 0x04, 0x78, // 'h'
+	0x00, 0x44, 0x7D, 0x40, 0x00, // 'i'
+	0x20, 0x40, 0x40, 0x3D, 0x00, // 'j'
+	0x7F, 0x10, 0x28, 0x44, 0x00, // 'k'
+	0x00, 0x41, 0x7F, 0x40, 0x00, // 'l'
+	0x7C, 0x04, 0x78, 0x04, 0x78, // 'm'
+	0x7C, 0x08, 0x04, 0x04, 0x78, // 'n'
+	0x38, 0x44, 0x44, 0x44, 0x38, // 'o'
+	0xFC, 0x18, 0x24, 0x24, 0x18, // 'p'
+	0x18, 0x24, 0x24, 0x18, 0xFC, // 'q'
+	0x7C, 0x08, 0x04, 0x04, 0x08, // 'r'
+	0x48, 0x54, 0x54, 0x54, 0x24, // 's'
+	0x04, 0x04, 0x3F, 0x44, 0x24, // 't'
+	0x3C, 0x40, 0x40, 0x20, 0x7C, // 'u'
+	0x1C, 0x20, 0x40, 0x20, 0x1C, // 'v'
+	0x3C, 0x40, 0x30, 0x40, 0x3C, // 'w'
+	0x44, 0x28, 0x10, 0x28, 0x44, // 'x'
+	0x4C, 0x90, 0x90, 0x90, 0x7C, // 'y'
+	0x44, 0x64, 0x54, 0x4C, 0x44, // 'z'
+	0x00, 0x08, 0x36, 0x41, 0x00, // '{'
+	0x00, 0x00, 0x77, 0x00, 0x00, // '|'
+	0x00, 0x41, 0x36, 0x08, 0x00, // '}'
+	0x02, 0x01, 0x02, 0x04, 0x02, // '~'
+	0x00, 0x00, 0x00, 0x00, 0x00, // 0x7F
+};
+
+const byte font3x5[] PROGMEM = {
+	3, 5,
+	0x00, 0x00, 0x00, // 0x00
+	0x00, 0x00, 0x00, // 0x01
+	0x00, 0x00, 0x00, // 0x02
+	0x00, 0x00, 0x00, // 0x03
+	0x00, 0x00, 0x00, // 0x04
+	0x00, 0x00, 0x00, // 0x05
+	0x00, 0x00, 0x00, // 0x06
+	0x00, 0x00, 0x00, // 0x07
+	0x00, 0x00, 0x00, // 0x08
+	0x00, 0x00, 0x00, // 0x09
+	0x00, 0x00, 0x00, // 0x0A
+	0x00, 0x00, 0x00, // 0x0B
+	0x00, 0x00, 0x00, // 0x0C
+	0x00, 0x00, 0x00, // 0x0D
+	0x00, 0x00, 0x00, // 0x0E
+	0x00, 0x00, 0x00, // 0x0F
+	0x00, 0x00, 0x00, // 0x10
+	0x00, 0x00, 0x00, // 0x11
+	0x00, 0x00, 0x00, // 0x12
+	0x00, 0x00, 0x00, // 0x13
+	0x00, 0x00, 0x00, // 0x14
+	0x00, 0x00, 0x00, // 0x15
+	0x00, 0x00, 0x00, // 0x16
+	0x00, 0x00, 0x00, // 0x17
+	0x00, 0x00, 0x00, // 0x18
+	0x00, 0x00, 0x00, // 0x19
+	0x00, 0x00, 0x00, // 0x1A
+	0x00, 0x00, 0x00, // 0x1B
+	0x00, 0x00, 0x00, // 0x1C
+	0x00, 0x00, 0x00, // 0x1D
+	0x00, 0x00, 0x00, // 0x1E
+	0x00, 0x00, 0x00, // 0x1F
+	0x00, 0x00, 0x00, // ' '
+	0x00, 0x1F, 0x00, // '!'
+	0x03, 0x00, 0x03, // '"'
+	0x1F, 0x0A, 0x1F, // '#'
+	0x06, 0x1F, 0x0C, // '$'
+	0x09, 0x04, 0x12, // '%'
+	0x1F, 0x1A, 0x18, // '&'
+	0x04, 0x03, 0x01, // '\''
+	0x0E, 0x00, 0x11, // '('
+	0x11, 0x00, 0x0E, // ')'
+	0x0E, 0x1F, 0x0E, // '*'
+	0x04, 0x0E, 0x04, // '+'
+	0x00, 0x18, 0x08, // ','
+	0x04, 0x04, 0x04, // '-'
+	0x00, 0x10, 0x10, // '.'
+	0x08, 0x04, 0x02, // '/'
+	0x1F, 0x15, 0x1F, // '0'
+	0x10, 0x1F, 0x10, // '1'
+	0x1D, 0x15, 0x17, // '2'
+	0x11, 0x15, 0x1F, // '3'
+	0x0E, 0x08, 0x1F, // '4'
+	0x13, 0x13, 0x1F, // '5'
+	0x1E, 0x15, 0x1D, // '6'
+	0x11, 0x09, 0x07, // '7'
+	0x1F, 0x15, 0x1F, // '8'
+	0x17, 0x15, 0x0F, // '9'
+	0x00, 0x0A, 0x00, // ':'
+	0x10, 0x0A, 0x00, // ';'
+	0x04, 0x0A, 0x11, // '<'
+	0x0A, 0x0A, 0x0A, // '='
+	0x11, 0x00, 0x0E, // '>'
+	0x01, 0x1D, 0x07, // '?'
+	0x1F, 0x1F, 0x1F, // '@'
+	0x1E, 0x09, 0x1E, // 'A'
+	0x1F, 0x15, 0x1F, // 'B'
+	0x1F, 0x11, 0x11, // 'C'
+	0x1F, 0x11, 0x1F, // 'D'
+	0x1F, 0x15, 0x15, // 'E'
+	0x1F, 0x05, 0x05, // 'F'
+	0x1F, 0x11, 0x19, // 'G'
+	0x1F, 0x04, 0x1F, // 'H'
+	0x11, 0x1F, 0x11, // 'I'
+	0x10, 0x11, 0x0F, // 'J'
+	0x1F, 0x0A, 0x11, // 'K'
+	0x1F, 0x10, 0x10, // 'L'
+	0x1F, 0x0E, 0x1F, // 'M'
+	0x1F, 0x04, 0x1F, // 'N'
+	0x1F, 0x11, 0x1F, // 'O'
+	0x1F, 0x05, 0x07, // 'P'
+	0x1F, 0x19, 0x1F, // 'Q'
+	0x1F, 0x0D, 0x17, // 'R'
+	0x17, 0x15, 0x1D, // 'S'
+	0x01, 0x1F, 0x01, // 'T'
+	0x1F, 0x10, 0x1F, // 'U'
+	0x0F, 0x10, 0x0F, // 'V'
+	0x1F, 0x0C, 0x1F, // 'W'
+	0x1B, 0x04, 0x1B, // 'X'
+	0x03, 0x1C, 0x03, // 'Y'
+	0x1D, 0x15, 0x17, // 'Z'
+	0x1F, 0x11, 0x11, // '['
+	0x02, 0x04, 0x08, // '\\'
+	0x11, 0x11, 0x1F, // ']'
+	0x02, 0x01, 0x02, // '^'
+	0x10, 0x10, 0x10, // '_'
+	0x01, 0x03, 0x04, // '`'
+	0x1A, 0x1A, 0x1C, // 'a'
+	0x1F, 0x12, 0x1E, // 'b'
+	0x1E, 0x12, 0x16, // 'c'
+	0x1E, 0x12, 0x1F, // 'd'
+	0x1E, 0x1A, 0x1E, // 'e'
+	0x04, 0x1E, 0x05, // 'f'
+	0x0E, 0x02, 0x1E, // 'g'
+	0x1F, 0x02, 0x1E, // 'h'
+	0x12, 0x1F, 0x10, // 'i'
+	0x10, 0x10, 0x0F, // 'j'
+	0x1F, 0x04, 0x12, // 'k'
+	0x11, 0x1F, 0x10, // 'l'
+	0x1E, 0x1C, 0x1E, // 'm'
+	0x1E, 0x02, 0x1E, // 'n'
+	0x1E, 0x12, 0x1E, // 'o'
+	0x1E, 0x02, 0x0E, // 'p'
+	0x0E, 0x02, 0x1E, // 'q'
+	0x1E, 0x02, 0x06, // 'r'
+	0x1E, 0x1A, 0x1A, // 's'
+	0x02, 0x0F, 0x12, // 't'
+	0x1E, 0x10, 0x1E, // 'u'
+	0x0E, 0x10, 0x0E, // 'v'
+	0x1E, 0x08, 0x1E, // 'w'
+	0x16, 0x08, 0x16, // 'x'
+	0x1E, 0x08, 0x1E, // 'y'
+	0x12, 0x1A, 0x16, // 'z'
+	0x04, 0x0A, 0x11, // '{'
+	0x00, 0x1B, 0x00, // '|'
+	0x11, 0x0A, 0x04, // '}'
+	0x01, 0x00, 0x02, // '~'
+	0x00, 0x00, 0x00, // 0x7F
+};
@@ -0,0 +1,51 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Latency summary. The sketch is compiled into this translation unit with
+// DARK_TOWER_LATENCY_PROBE defined and played with scripted button presses.
+// The reports it sends along the way are dropped, and the one it would send
+// next, covering every press, is printed at the end. The shim's clock moves
+// on a frame at a time, so the times show how many frames presses take to
+// settle on screen rather than how long the device takes to draw them.
+//
+// usage: dark_tower_latency [frames] [seed]
+
+#define DARK_TOWER_LATENCY_PROBE
+#include "../../DarkTower.cpp"
+
+#include <gamebuino_host.h>
+
+#include "scripted_input.h"
+
+#include <stdlib.h>
+
+int main(int argc, char **argv){
+	uint32_t frames = argc > 1 ? strtoul(argv[1], NULL, 10) : 20000;
+	uint32_t seed = argc > 2 ? strtoul(argv[2], NULL, 10) : 1;
+	scripted_input_type input(seed);
+
+	setup();
+	for (uint32_t frame = 0; frame < frames; frame++){
+		host_set_buttons(input.next_frame());
+		loop();
+	}
+
+	host_set_serial_output(stdout);
+	latency_probe.send_report();
+	return 0;
+}
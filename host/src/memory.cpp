@@ -0,0 +1,63 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Memory report. The sketch is compiled into this translation unit with
+// DARK_TOWER_MEMORY_REPORT defined, played with scripted button presses, and
+// then asked for its memory report over Serial, as on the device. The sizes
+// are the host's, which has wider pointers and its own C library, but they
+// show which globals are the largest and how they change.
+//
+// usage: dark_tower_memory [frames] [seed]
+
+#define DARK_TOWER_MEMORY_REPORT
+#include "../../DarkTower.cpp"
+
+#include <gamebuino_host.h>
+
+#include "scripted_input.h"
+
+#include <stdlib.h>
+
+static uint32_t session_frames;
+static uint32_t session_seed;
+
+// Runs on the shim's painted stack, so that the report can say how deep the
+// sketch's stack has gone.
+static void run_session(){
+	scripted_input_type input(session_seed);
+
+	setup();
+	for (uint32_t frame = 0; frame < session_frames; frame++){
+		host_set_buttons(input.next_frame());
+		loop();
+	}
+
+	const char request[] = { MEMORY_REPORT_REQUEST, '\0' };
+	host_send_serial_input(request);
+	host_set_buttons(0);
+	loop();
+}
+
+int main(int argc, char **argv){
+	session_frames = argc > 1 ? strtoul(argv[1], NULL, 10) : 20000;
+	session_seed = argc > 2 ? strtoul(argv[2], NULL, 10) : 1;
+
+	host_set_serial_output(stdout);
+	host_run_on_painted_stack(run_session);
+	return 0;
+}
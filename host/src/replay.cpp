@@ -0,0 +1,183 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Input replay. The sketch is compiled into this translation unit with
+// DARK_TOWER_RECORD_INPUT defined, as a recording build is, and recordings
+// are played back through loop() as fast as the host runs, with a checksum of
+// the display buffer for every frame. Two builds that print the same
+// checksums for a recording drew the same pixels.
+//
+// usage: dark_tower_replay [-q] recording...
+//        dark_tower_replay -r frames seed recording
+//
+// Each recording is replayed in a forked process, so that each starts from a
+// freshly started sketch. Every frame is printed as its number and checksum;
+// with -q, only a line for each recording is, with its number of frames and a
+// digest of all their checksums. -r records a session of scripted button
+// presses the way the device would, and prints its checksums the same way.
+
+#define DARK_TOWER_RECORD_INPUT
+#include "../../DarkTower.cpp"
+
+#include <gamebuino_host.h>
+
+#include "scripted_input.h"
+
+#include <chrono>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// FNV-1a, 32 bits.
+#define CHECKSUM_BASIS 2166136261u
+#define CHECKSUM_PRIME 16777619u
+
+#define RECORD_SIZE 3
+
+typedef std::chrono::steady_clock replay_clock;
+
+static uint32_t add_to_checksum(uint32_t checksum, const uint8_t *bytes, size_t size){
+	for (size_t i = 0; i < size; i++){
+		checksum ^= bytes[i];
+		checksum *= CHECKSUM_PRIME;
+	}
+	return checksum;
+}
+
+// Runs one frame of the sketch and returns the checksum of what it drew.
+static uint32_t run_frame(uint8_t buttons){
+	host_set_buttons(buttons);
+	loop();
+	return add_to_checksum(CHECKSUM_BASIS, gb.display.getBuffer(), LCDWIDTH * LCDHEIGHT / 8);
+}
+
+// Reads the buttons held in each frame of a recording, up to the frame of its
+// last record.
+static bool read_recording(const char *path, std::vector<uint8_t>& frames){
+	FILE *file = fopen(path, "rb");
+	if (file == NULL){
+		fprintf(stderr, "dark_tower_replay: cannot open %s\n", path);
+		return false;
+	}
+
+	char magic[sizeof(INPUT_RECORDING_MAGIC) - 1];
+	bool valid = fread(magic, 1, sizeof(magic), file) == sizeof(magic)
+		&& memcmp(magic, INPUT_RECORDING_MAGIC, sizeof(magic)) == 0;
+
+	uint8_t record[RECORD_SIZE];
+	uint8_t buttons = 0;
+	size_t record_size;
+	frames.clear();
+	while (valid && (record_size = fread(record, 1, sizeof(record), file)) > 0){
+		if (record_size != sizeof(record)){
+			valid = false;
+			break;
+		}
+		frames.insert(frames.end(), record[0] | (record[1] << 8), buttons);
+		buttons = record[2];
+	}
+	if (valid && !frames.empty())
+		frames.push_back(buttons);
+	fclose(file);
+
+	if (!valid)
+		fprintf(stderr, "dark_tower_replay: %s is not a recording\n", path);
+	return valid;
+}
+
+static void replay(const char *path, const std::vector<uint8_t>& frames, bool quiet){
+	uint32_t digest = CHECKSUM_BASIS;
+
+	setup();
+	for (uint32_t frame = 0; frame < frames.size(); frame++){
+		uint32_t checksum = run_frame(frames[frame]);
+		if (!quiet)
+			printf("%u %08x\n", frame, checksum);
+		digest = add_to_checksum(digest, (const uint8_t*)&checksum, sizeof(checksum));
+	}
+	if (quiet)
+		printf("%s %u %08x\n", path, (unsigned)frames.size(), digest);
+}
+
+static bool replay_in_own_process(const char *path, const std::vector<uint8_t>& frames, bool quiet){
+	fflush(stdout);
+	pid_t pid = fork();
+	if (pid < 0){
+		perror("dark_tower_replay: fork");
+		return false;
+	}
+	if (pid == 0){
+		replay(path, frames, quiet);
+		fflush(stdout);
+		_exit(0);
+	}
+
+	int status;
+	return waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static int record(uint32_t frames, uint32_t seed, const char *path){
+	FILE *file = fopen(path, "wb");
+	if (file == NULL){
+		fprintf(stderr, "dark_tower_replay: cannot create %s\n", path);
+		return 1;
+	}
+
+	scripted_input_type input(seed);
+	host_set_serial_output(file);
+	setup();
+	for (uint32_t frame = 0; frame < frames; frame++)
+		printf("%u %08x\n", frame, run_frame(input.next_frame()));
+	host_set_serial_output(NULL);
+	return fclose(file) == 0 ? 0 : 1;
+}
+
+int main(int argc, char **argv){
+	if (argc == 5 && strcmp(argv[1], "-r") == 0)
+		return record(strtoul(argv[2], NULL, 10), strtoul(argv[3], NULL, 10), argv[4]);
+
+	bool quiet = argc > 1 && strcmp(argv[1], "-q") == 0;
+	int first_path = quiet ? 2 : 1;
+	if (first_path >= argc){
+		fprintf(stderr, "usage: dark_tower_replay [-q] recording...\n");
+		fprintf(stderr, "       dark_tower_replay -r frames seed recording\n");
+		return 2;
+	}
+
+	std::vector<uint8_t> frames;
+	uint64_t frame_count = 0;
+	int failures = 0;
+	replay_clock::time_point started = replay_clock::now();
+
+	for (int i = first_path; i < argc; i++){
+		if (read_recording(argv[i], frames) && replay_in_own_process(argv[i], frames, quiet))
+			frame_count += frames.size();
+		else
+			failures++;
+	}
+
+	double elapsed_s = std::chrono::duration<double>(replay_clock::now() - started).count();
+	fprintf(stderr, "replayed %llu frames from %d recordings in %.3f s (%.0f frames/s)\n"
+		, (unsigned long long)frame_count
+		, argc - first_path - failures
+		, elapsed_s
+		, elapsed_s > 0 ? frame_count / elapsed_s : 0.0
+		);
+	return failures > 0 ? 1 : 0;
+}
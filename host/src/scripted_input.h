@@ -0,0 +1,63 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Scripted button presses, shared by the host drivers. Include after the
+// sketch, for the button numbers.
+
+#ifndef HOST_SCRIPTED_INPUT_H
+#define HOST_SCRIPTED_INPUT_H
+
+// Presses a random direction, A or B for a few frames at a time, with gaps in
+// between so every press registers as a new one. C is never pressed, so play
+// never drops back to the title screen.
+class scripted_input_type {
+public:
+	scripted_input_type(uint32_t seed)
+	: random_state( seed )
+	, frames_left( 0 )
+	, cur_buttons( 0 )
+	{ }
+
+	uint8_t next_frame(){
+		if (frames_left == 0){
+			if (cur_buttons == 0){
+				const uint8_t buttons[] = { BTN_LEFT, BTN_UP, BTN_RIGHT, BTN_DOWN, BTN_A, BTN_B };
+				cur_buttons = 1 << buttons[next_random() % sizeof(buttons)];
+				frames_left = 1 + next_random() % 3;
+			}
+			else {
+				cur_buttons = 0;
+				frames_left = 1 + next_random() % 4;
+			}
+		}
+		frames_left--;
+		return cur_buttons;
+	}
+
+private:
+	uint32_t random_state;
+	uint8_t frames_left;
+	uint8_t cur_buttons;
+
+	uint32_t next_random(){
+		random_state = random_state * 1103515245 + 12345;
+		return random_state >> 16;
+	}
+};
+
+#endif
@@ -0,0 +1,868 @@
+/*
+ * Dark Tower - host build
+ * Copyright (C) 2018 Marcus Hutchings
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Exhaustive game-state solver. The sketch is compiled into this translation
+// unit, as in bench.cpp, and the rooms' own handlers are run on every state
+// the game can reach, breadth first, to check the story after changing it.
+//
+// usage: dark_tower_solver [workers]
+//
+// A state is what the room handlers read: the room and its local event tags,
+// the items carried, the achievements and the room flags. From each state
+// every action is tried on every object, and every item carried on every
+// object, as the menus offer them. An answer that returns to the room leads
+// back to that room as the handler left it; the story's own events are
+// followed on to the room they end in. Reaching the win event wins, and
+// dying ends the path, since the game starts over.
+//
+// The sketch keeps the game in globals, so the workers are forked processes,
+// each with its own copy, that take chunks of states from a queue over pipes.
+// The parent keeps the visited states and merges each level's replies in
+// queue order, so the results do not depend on the number of workers.
+//
+// It reports whether the game can be won, the shortest way to win, the states
+// from which it can no longer be won, the texts and objects that never show,
+// and the descriptions cut short by DESCRIPTION_MAX_TEXTS or
+// DESCRIPTION_MAX_LINES. It exits with 1 if the game cannot be won or a
+// description is cut short.
+//
+// It then nests plain events past EVENT_HISTORY_DEPTH in the presenter and
+// goes back through them, which the story itself never does, and exits with 1
+// if any step back shows the wrong event or scroll position.
+
+#define DARK_TOWER_TEXT_NAMES
+#define DARK_TOWER_ROOM_NAMES
+#include "../../DarkTower.cpp"
+
+#include <chrono>
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#define SOLVER_CHUNK_STATES 32
+#define SOLVER_MAX_STORY_EVENTS 16
+#define SOLVER_MAX_REPORTED_DEAD_ENDS 8
+#define SOLVER_NAME_LENGTH 64
+#define SOLVER_HISTORY_LEVELS (2 * EVENT_HISTORY_DEPTH + 3)
+#define SOLVER_HISTORY_SCROLL_SPAN 4
+
+#define SOLVER_OUTCOME_STATE 0
+#define SOLVER_OUTCOME_WIN 1
+#define SOLVER_OUTCOME_DIES 2
+
+#define SOLVER_NO_PARENT 0xffffffff
+
+#define ROOM_OBJECT_COUNT (sizeof(room_objects) / sizeof(room_objects[0]))
+#define TEXT_STREAM_SIZE (sizeof(text_streams))
+
+typedef std::chrono::steady_clock solver_clock;
+
+// ------------------------------------------------
+// States
+// ------------------------------------------------
+
+// Packed into bytes: the room, its local event tags and the achievements,
+// then a bit for each room flag and a bit for each item, so the key grows with
+// ROOM_FLAG_COUNT and PLAYER_ITEM_COUNT.
+#define SOLVER_FLAG_BYTES ((ROOM_FLAG_COUNT + 7) / 8)
+#define SOLVER_ITEM_BYTES ((PLAYER_ITEM_COUNT + 7) / 8)
+#define SOLVER_KEY_SIZE (3 + SOLVER_FLAG_BYTES + SOLVER_ITEM_BYTES)
+
+struct solver_key_type
+{
+	uint8_t bytes[SOLVER_KEY_SIZE];
+
+	bool operator==(const solver_key_type& other) const {
+		return memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+	}
+};
+
+// FNV-1a over the packed bytes, 64 bits.
+#define SOLVER_HASH_BASIS 14695981039346656037ULL
+#define SOLVER_HASH_PRIME 1099511628211ULL
+
+struct solver_key_hash_type
+{
+	size_t operator()(const solver_key_type& key) const {
+		uint64_t hash = SOLVER_HASH_BASIS;
+		for (uint8_t i = 0; i < SOLVER_KEY_SIZE; i++){
+			hash ^= key.bytes[i];
+			hash *= SOLVER_HASH_PRIME;
+		}
+		return hash;
+	}
+};
+
+template <uint16_t bit_count>
+static void pack_set(bit_set_type<bit_count>& set, uint8_t *bytes){
+	for (uint16_t bit = 0; bit < bit_count; bit++)
+		if (set.test(bit))
+			bytes[bit >> 3] |= 1 << (bit & 7);
+}
+
+template <uint16_t bit_count>
+static void unpack_set(const uint8_t *bytes, bit_set_type<bit_count>& set){
+	for (uint16_t bit = 0; bit < bit_count; bit++)
+		if (bytes[bit >> 3] & (1 << (bit & 7)))
+			set.set(bit);
+}
+
+struct solver_state_type
+{
+	room_id room;
+	uint8_t local_event_tags;
+	event_tag_id achievements;
+	room_state_type room_flags;
+	bit_set_type<PLAYER_ITEM_COUNT> items;
+
+	solver_key_type pack(){
+		solver_key_type key = { };
+		key.bytes[0] = room;
+		key.bytes[1] = local_event_tags;
+		key.bytes[2] = achievements;
+		pack_set(room_flags, &key.bytes[3]);
+		pack_set(items, &key.bytes[3 + SOLVER_FLAG_BYTES]);
+		return key;
+	}
+
+	static solver_state_type unpack(const solver_key_type& key){
+		solver_state_type state;
+		state.room = key.bytes[0];
+		state.local_event_tags = key.bytes[1];
+		state.achievements = key.bytes[2];
+		unpack_set(&key.bytes[3], state.room_flags);
+		unpack_set(&key.bytes[3 + SOLVER_FLAG_BYTES], state.items);
+		return state;
+	}
+};
+
+// One action tried in a state, and where it led.
+struct solver_edge_type
+{
+	uint8_t action;
+	uint8_t object;
+	player_item_id item;
+	uint8_t outcome;
+	solver_key_type next_state;
+};
+
+// Texts and room objects shown so far, and the first texts of descriptions cut
+// short, one byte each so they merge by OR.
+static uint8_t seen_texts[TEXT_STREAM_SIZE];
+static uint8_t seen_objects[ROOM_OBJECT_COUNT];
+static uint8_t cut_short_texts[TEXT_STREAM_SIZE];
+
+static void mark_text(text_id text){
+	if (text != TEXT_NONE)
+		seen_texts[text] = 1;
+}
+
+static void mark_event(event& shown_event){
+	description_type description;
+	description.clear(LCDWIDTH);
+	shown_event.load_description(description);
+	for (uint8_t i = 0; i < description.get_text_count(); i++)
+		mark_text(description.get_text(i));
+	if (description.is_cut_short())
+		cut_short_texts[description.get_text(0)] = 1;
+
+	// The action menu shown under it.
+	if (shown_event.actions_are_allowed())
+		for (uint8_t action = 0; action < sizeof(standard_actions) / sizeof(standard_actions[0]); action++)
+			mark_text(pgm_read_word(&standard_actions[action]));
+	else
+		mark_text(pgm_read_word(&continue_actions[0]));
+}
+
+// Sets up the globals for a state and builds its room into slot. Inlined into
+// describe_step(), it leads g++ 12 to warn that the room built here may be
+// used uninitialised, which it is not.
+static __attribute__((noinline)) void enter_state(const solver_state_type& state, event& slot){
+	player.get_items() = state.items;
+	player.remove_achievement(EVENT_TAG_ID_ALL);
+	player.add_achievement(state.achievements);
+	room_state = state.room_flags;
+	build_event<room_event>(slot, state.room, state.local_event_tags);
+}
+
+static solver_state_type current_state(event& room){
+	solver_state_type state;
+	state.room = room.get_room();
+	state.local_event_tags = room.get_local_event_tags();
+	state.achievements = player.get_achievements();
+	state.room_flags = room_state;
+	state.items = player.get_items();
+	return state;
+}
+
+static void mark_objects(room_id room, text_id menu[OBJECT_MENU_LENGTH], uint8_t object_count){
+	uint16_t first_object = pgm_read_word(&rooms[room].first_object);
+	uint8_t table_count = pgm_read_byte(&rooms[room].object_count);
+
+	for (uint8_t i = 0; i < object_count; i++){
+		// A room's class may offer a name other than the one in its table.
+		if (i < table_count && menu[i] == pgm_read_word(&room_objects[first_object + i].name))
+			seen_objects[first_object + i] = 1;
+		mark_text(menu[i]);
+	}
+}
+
+// Follows the story's own events from slots[cur_slot] on to the room they end
+// in, and says whether the player won or died on the way.
+static uint8_t follow_events(event slots[EVENT_MEMORY], uint8_t cur_slot, solver_key_type& next_state){
+	uint8_t outcome = SOLVER_OUTCOME_STATE;
+
+	for (uint8_t steps = 0; steps < SOLVER_MAX_STORY_EVENTS; steps++){
+		event& cur_event = slots[cur_slot];
+		mark_event(cur_event);
+		if (cur_event.actions_are_allowed()){
+			next_state = current_state(cur_event).pack();
+			return outcome;
+		}
+
+		// Carry on past the end so the texts that follow it are seen.
+		if (outcome == SOLVER_OUTCOME_STATE){
+			if (cur_event.get_type() == EVENT_TYPE_ID_WIN)
+				outcome = SOLVER_OUTCOME_WIN;
+			else if (cur_event.get_type() == EVENT_TYPE_ID_PLAYER_DIES)
+				outcome = SOLVER_OUTCOME_DIES;
+		}
+
+		uint8_t next_slot = (cur_slot + 1) % EVENT_MEMORY;
+		cur_event.get_continue_event(slots[next_slot]);
+		cur_slot = next_slot;
+	}
+
+	fprintf(stderr, "dark_tower_solver: story events of type %d do not lead back to a room\n", slots[cur_slot].get_type());
+	exit(2);
+}
+
+static solver_edge_type try_action(const solver_state_type& state, uint8_t action, uint8_t object, player_item_id item){
+	solver_edge_type edge = { action, object, item, SOLVER_OUTCOME_STATE, { } };
+	event slots[EVENT_MEMORY];
+
+	enter_state(state, slots[0]);
+	if (action == ACTION_ID_ITEM)
+		slots[0].process_item_on_object(item, object, slots[1]);
+	else
+		slots[0].process_action_on_object(action, object, slots[1]);
+
+	if (!slots[1].actions_are_allowed() && slots[1].should_return_to_previous_event()){
+		mark_event(slots[1]);
+		edge.next_state = current_state(slots[0]).pack();
+		return edge;
+	}
+	edge.outcome = follow_events(slots, 1, edge.next_state);
+	return edge;
+}
+
+static void expand_state(const solver_key_type& packed_state, std::vector<solver_edge_type>& edges){
+	solver_state_type state = solver_state_type::unpack(packed_state);
+	text_id menu[OBJECT_MENU_LENGTH];
+	event room;
+
+	enter_state(state, room);
+	mark_event(room);
+	uint8_t object_count = room.load_object_menu(menu, OBJECT_MENU_LENGTH);
+	mark_objects(state.room, menu, object_count);
+
+	for (uint8_t action = ACTION_ID_LOOK; action < ACTION_ID_ITEM; action++)
+		for (uint8_t object = 0; object < object_count; object++)
+			edges.push_back(try_action(state, action, object, 0));
+
+	// The item menu lists no more than MAX_OBJECTS_ON_PLAYER items.
+	bool has_items = false;
+	uint8_t items_listed = 0;
+	for (player_item_id item = 0; item < PLAYER_ITEM_COUNT && items_listed < MAX_OBJECTS_ON_PLAYER; item++){
+		if (!state.items.test(item))
+			continue;
+		has_items = true;
+		items_listed++;
+		mark_text(pgm_read_word(&player_item_name_full_list[item]));
+		for (uint8_t object = 0; object < object_count; object++)
+			edges.push_back(try_action(state, ACTION_ID_ITEM, object, item));
+	}
+	if (!has_items)
+		mark_text(TEXT_NO_USEFUL_ITEMS);
+}
+
+// ------------------------------------------------
+// Workers
+// ------------------------------------------------
+
+static bool write_fully(int fd, const void *data, size_t size){
+	const uint8_t *cur = (const uint8_t*)data;
+	while (size > 0){
+		ssize_t written = write(fd, cur, size);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			return false;
+		cur += written;
+		size -= written;
+	}
+	return true;
+}
+
+static bool read_fully(int fd, void *data, size_t size){
+	uint8_t *cur = (uint8_t*)data;
+	while (size > 0){
+		ssize_t got = read(fd, cur, size);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got <= 0)
+			return false;
+		cur += got;
+		size -= got;
+	}
+	return true;
+}
+
+// A message is its length, then its bytes.
+static bool send_message(int fd, const std::vector<uint8_t>& message){
+	uint32_t size = message.size();
+	return write_fully(fd, &size, sizeof(size)) && write_fully(fd, message.data(), size);
+}
+
+static bool receive_message(int fd, std::vector<uint8_t>& message){
+	uint32_t size;
+	if (!read_fully(fd, &size, sizeof(size)))
+		return false;
+	message.resize(size);
+	return read_fully(fd, message.data(), size);
+}
+
+template <typename value_type>
+static void put(std::vector<uint8_t>& message, const value_type& value){
+	const uint8_t *bytes = (const uint8_t*)&value;
+	message.insert(message.end(), bytes, bytes + sizeof(value));
+}
+
+template <typename value_type>
+static value_type get(const std::vector<uint8_t>& message, size_t& offset){
+	value_type value;
+	memcpy(&value, &message[offset], sizeof(value));
+	offset += sizeof(value);
+	return value;
+}
+
+// A request is a chunk of packed states. The reply holds, for each state, the
+// number of its edges and the edges, then the texts and objects the worker
+// has seen so far.
+static void run_worker(int request_fd, int reply_fd){
+	std::vector<uint8_t> request;
+	std::vector<uint8_t> reply;
+	std::vector<solver_edge_type> edges;
+
+	while (receive_message(request_fd, request)){
+		reply.clear();
+		for (size_t offset = 0; offset < request.size(); ){
+			edges.clear();
+			expand_state(get<solver_key_type>(request, offset), edges);
+			put(reply, (uint32_t)edges.size());
+			for (const solver_edge_type& edge : edges)
+				put(reply, edge);
+		}
+		reply.insert(reply.end(), seen_texts, seen_texts + sizeof(seen_texts));
+		reply.insert(reply.end(), seen_objects, seen_objects + sizeof(seen_objects));
+		reply.insert(reply.end(), cut_short_texts, cut_short_texts + sizeof(cut_short_texts));
+		if (!send_message(reply_fd, reply))
+			break;
+	}
+	_exit(0);
+}
+
+class solver_worker_pool_type {
+public:
+	void start(unsigned worker_count){
+		for (unsigned i = 0; i < worker_count; i++){
+			int requests[2];
+			int replies[2];
+			if (pipe(requests) != 0 || pipe(replies) != 0)
+				fail("pipe");
+
+			pid_t pid = fork();
+			if (pid < 0)
+				fail("fork");
+			if (pid == 0){
+				// Only this worker's own ends stay open, so it sees the end of
+				// the queue when the parent closes its side.
+				close(requests[1]);
+				close(replies[0]);
+				for (const worker_type& other : workers){
+					close(other.request_fd);
+					close(other.reply_fd);
+				}
+				run_worker(requests[0], replies[1]);
+			}
+			close(requests[0]);
+			close(replies[1]);
+
+			worker_type worker = { pid, requests[1], replies[0], -1 };
+			workers.push_back(worker);
+		}
+	}
+
+	// Expands every chunk of states on the workers, and returns the replies in
+	// the order of the chunks.
+	std::vector<std::vector<uint8_t>> expand(const std::vector<std::vector<uint8_t>>& chunks){
+		std::vector<std::vector<uint8_t>> replies(chunks.size());
+		size_t next_chunk = 0;
+		size_t chunks_done = 0;
+
+		while (chunks_done < chunks.size()){
+			for (worker_type& worker : workers){
+				if (worker.chunk < 0 && next_chunk < chunks.size()){
+					if (!send_message(worker.request_fd, chunks[next_chunk]))
+						fail("write to worker");
+					worker.chunk = next_chunk++;
+				}
+			}
+
+			std::vector<pollfd> busy;
+			for (const worker_type& worker : workers){
+				if (worker.chunk >= 0){
+					pollfd reply = { worker.reply_fd, POLLIN, 0 };
+					busy.push_back(reply);
+				}
+			}
+			if (poll(busy.data(), busy.size(), -1) < 0){
+				if (errno == EINTR)
+					continue;
+				fail("poll");
+			}
+
+			for (const pollfd& reply : busy){
+				if (reply.revents == 0)
+					continue;
+				for (worker_type& worker : workers){
+					if (worker.reply_fd != reply.fd)
+						continue;
+					if (!receive_message(worker.reply_fd, replies[worker.chunk]))
+						fail("read from worker");
+					worker.chunk = -1;
+					chunks_done++;
+				}
+			}
+		}
+		return replies;
+	}
+
+	void stop(){
+		for (const worker_type& worker : workers){
+			close(worker.request_fd);
+			close(worker.reply_fd);
+			waitpid(worker.pid, NULL, 0);
+		}
+		workers.clear();
+	}
+
+private:
+	struct worker_type
+	{
+		pid_t pid;
+		int request_fd;
+		int reply_fd;
+		int chunk;
+	};
+
+	static void fail(const char *what){
+		fprintf(stderr, "dark_tower_solver: %s failed: %s\n", what, strerror(errno));
+		exit(2);
+	}
+
+	std::vector<worker_type> workers;
+};
+
+// ------------------------------------------------
+// Search
+// ------------------------------------------------
+
+struct solver_node_type
+{
+	solver_key_type state;
+	uint32_t parent;
+	solver_edge_type reached_by;
+	uint16_t depth;
+	bool can_win;
+};
+
+class solver_type {
+public:
+	solver_type()
+	: edge_count( 0 )
+	, win_node( SOLVER_NO_PARENT )
+	{ }
+
+	void search(const solver_key_type& start_state, solver_worker_pool_type& pool){
+		add_node(start_state, SOLVER_NO_PARENT, NULL);
+		std::vector<uint32_t> frontier(1, 0);
+
+		while (!frontier.empty()){
+			std::vector<std::vector<uint8_t>> chunks;
+			for (size_t i = 0; i < frontier.size(); i++){
+				if (i % SOLVER_CHUNK_STATES == 0)
+					chunks.push_back(std::vector<uint8_t>());
+				put(chunks.back(), nodes[frontier[i]].state);
+			}
+
+			std::vector<std::vector<uint8_t>> replies = pool.expand(chunks);
+			std::vector<uint32_t> next_frontier;
+			size_t frontier_index = 0;
+
+			for (const std::vector<uint8_t>& reply : replies){
+				size_t offset = 0;
+				size_t states_in_chunk = std::min<size_t>(SOLVER_CHUNK_STATES, frontier.size() - frontier_index);
+				for (size_t i = 0; i < states_in_chunk; i++)
+					merge_edges(frontier[frontier_index++], reply, offset, next_frontier);
+				merge_seen(reply, offset);
+			}
+			frontier.swap(next_frontier);
+		}
+
+		find_dead_ends();
+	}
+
+	void report(){
+		printf("%u states, %u transitions\n", (unsigned)nodes.size(), edge_count);
+
+		if (win_node == SOLVER_NO_PARENT)
+			printf("the game cannot be won\n");
+		else {
+			printf("the game can be won in %u actions:\n", nodes[win_node].depth + 1);
+			print_path(win_node);
+			printf("  %3u. %s\n", nodes[win_node].depth + 1, describe_step(nodes[win_node].state, win_edge).c_str());
+		}
+
+		report_dead_ends();
+		report_unseen_texts();
+		report_unseen_objects();
+		report_cut_short_descriptions();
+	}
+
+	bool can_win(){
+		return win_node != SOLVER_NO_PARENT;
+	}
+
+	bool has_cut_short_descriptions(){
+		for (size_t i = 0; i < TEXT_STREAM_SIZE; i++)
+			if (cut_short_texts[i])
+				return true;
+		return false;
+	}
+
+private:
+	uint32_t add_node(const solver_key_type& state, uint32_t parent, const solver_edge_type *reached_by){
+		solver_node_type node = { state, parent, { }, 0, false };
+		if (reached_by != NULL){
+			node.reached_by = *reached_by;
+			node.depth = nodes[parent].depth + 1;
+		}
+		uint32_t node_id = nodes.size();
+		nodes.push_back(node);
+		predecessors.push_back(std::vector<uint32_t>());
+		node_ids.insert(std::make_pair(state, node_id));
+		return node_id;
+	}
+
+	void merge_edges(uint32_t node_id, const std::vector<uint8_t>& reply, size_t& offset, std::vector<uint32_t>& next_frontier){
+		uint32_t count = get<uint32_t>(reply, offset);
+		edge_count += count;
+
+		for (uint32_t i = 0; i < count; i++){
+			solver_edge_type edge = get<solver_edge_type>(reply, offset);
+
+			if (edge.outcome == SOLVER_OUTCOME_WIN){
+				nodes[node_id].can_win = true;
+				if (win_node == SOLVER_NO_PARENT){
+					win_node = node_id;
+					win_edge = edge;
+				}
+			}
+			if (edge.outcome != SOLVER_OUTCOME_STATE || edge.next_state == nodes[node_id].state)
+				continue;
+
+			auto next_node = node_ids.find(edge.next_state);
+			uint32_t next_id;
+			if (next_node == node_ids.end()){
+				next_id = add_node(edge.next_state, node_id, &edge);
+				next_frontier.push_back(next_id);
+			}
+			else
+				next_id = next_node->second;
+			predecessors[next_id].push_back(node_id);
+		}
+	}
+
+	void merge_seen(const std::vector<uint8_t>& reply, size_t& offset){
+		for (size_t i = 0; i < TEXT_STREAM_SIZE; i++)
+			seen_texts[i] |= reply[offset++];
+		for (size_t i = 0; i < ROOM_OBJECT_COUNT; i++)
+			seen_objects[i] |= reply[offset++];
+		for (size_t i = 0; i < TEXT_STREAM_SIZE; i++)
+			cut_short_texts[i] |= reply[offset++];
+	}
+
+	// Works back from the states with a winning action to every state that
+	// can still reach one.
+	void find_dead_ends(){
+		std::vector<uint32_t> pending;
+		for (uint32_t i = 0; i < nodes.size(); i++)
+			if (nodes[i].can_win)
+				pending.push_back(i);
+
+		while (!pending.empty()){
+			uint32_t node_id = pending.back();
+			pending.pop_back();
+			for (uint32_t predecessor : predecessors[node_id]){
+				if (!nodes[predecessor].can_win){
+					nodes[predecessor].can_win = true;
+					pending.push_back(predecessor);
+				}
+			}
+		}
+	}
+
+	void report_dead_ends(){
+		std::vector<uint32_t> dead_ends;
+		for (uint32_t i = 0; i < nodes.size(); i++)
+			if (!nodes[i].can_win)
+				dead_ends.push_back(i);
+
+		printf("%u dead-end states, from which the game cannot be won\n", (unsigned)dead_ends.size());
+		for (size_t i = 0; i < dead_ends.size() && i < SOLVER_MAX_REPORTED_DEAD_ENDS; i++){
+			printf("  %s, after:\n", describe_state(nodes[dead_ends[i]].state).c_str());
+			print_path(dead_ends[i]);
+		}
+		if (dead_ends.size() > SOLVER_MAX_REPORTED_DEAD_ENDS)
+			printf("  ... and %u more\n", (unsigned)(dead_ends.size() - SOLVER_MAX_REPORTED_DEAD_ENDS));
+	}
+
+	void report_unseen_texts(){
+		std::vector<const char*> unseen;
+		for (uint16_t i = 0; i < TEXT_NAME_COUNT; i++)
+			if (!seen_texts[text_names[i].text])
+				unseen.push_back(text_names[i].name);
+
+		printf("%u texts never shown\n", (unsigned)unseen.size());
+		for (const char *name : unseen)
+			printf("  %s\n", name);
+	}
+
+	void report_unseen_objects(){
+		std::vector<std::string> unseen;
+		for (room_id room = 0; room < ROOM_COUNT; room++){
+			uint16_t first_object = pgm_read_word(&rooms[room].first_object);
+			uint8_t object_count = pgm_read_byte(&rooms[room].object_count);
+			for (uint8_t i = 0; i < object_count; i++)
+				if (!seen_objects[first_object + i])
+					unseen.push_back(std::string(room_names[room]) + ": " + text_name(pgm_read_word(&room_objects[first_object + i].name)));
+		}
+
+		printf("%u room objects never offered\n", (unsigned)unseen.size());
+		for (const std::string& name : unseen)
+			printf("  %s\n", name.c_str());
+	}
+
+	// Named by the first of their texts.
+	void report_cut_short_descriptions(){
+		std::vector<const char*> cut_short;
+		for (uint16_t i = 0; i < TEXT_NAME_COUNT; i++)
+			if (cut_short_texts[text_names[i].text])
+				cut_short.push_back(text_names[i].name);
+
+		printf("%u descriptions cut short\n", (unsigned)cut_short.size());
+		for (const char *name : cut_short)
+			printf("  %s\n", name);
+	}
+
+	void print_path(uint32_t node_id){
+		std::vector<uint32_t> path;
+		for (; nodes[node_id].parent != SOLVER_NO_PARENT; node_id = nodes[node_id].parent)
+			path.push_back(node_id);
+
+		uint16_t step = 1;
+		for (auto cur_node = path.rbegin(); cur_node != path.rend(); ++cur_node)
+			printf("  %3u. %s\n", step++, describe_step(nodes[nodes[*cur_node].parent].state, nodes[*cur_node].reached_by).c_str());
+	}
+
+	static std::string text_name(text_id text){
+		char name[SOLVER_NAME_LENGTH];
+		expand_text(text, name, sizeof(name) - 1);
+		return name;
+	}
+
+	// The action as the menus showed it, such as "f1_main_hall: Use Lamp on Door".
+	static std::string describe_step(const solver_key_type& packed_state, const solver_edge_type& edge){
+		solver_state_type state = solver_state_type::unpack(packed_state);
+		text_id menu[OBJECT_MENU_LENGTH];
+		event room;
+
+		enter_state(state, room);
+		room.load_object_menu(menu, OBJECT_MENU_LENGTH);
+
+		std::string step = std::string(room_names[state.room]) + ": ";
+		if (edge.action == ACTION_ID_ITEM){
+			step += "Use " + text_name(pgm_read_word(&player_item_name_full_list[edge.item])) + " on ";
+		}
+		else
+			step += text_name(pgm_read_word(&standard_actions[edge.action])) + " ";
+		return step + text_name(menu[edge.object]);
+	}
+
+	static std::string describe_state(const solver_key_type& packed_state){
+		solver_state_type state = solver_state_type::unpack(packed_state);
+		char tags[SOLVER_NAME_LENGTH];
+
+		snprintf(tags, sizeof(tags), " (tags 0x%02x, achievements 0x%02x)", state.local_event_tags, state.achievements);
+		std::string description = std::string(room_names[state.room]) + tags + ", carrying";
+		if (state.items.count() == 0)
+			description += " nothing";
+		for (player_item_id item = 0; item < PLAYER_ITEM_COUNT; item++)
+			if (state.items.test(item))
+				description += " [" + text_name(pgm_read_word(&player_item_name_full_list[item])) + "]";
+		for (room_flag_id flag = 0; flag < ROOM_FLAG_COUNT; flag++)
+			if (state.room_flags.test(flag))
+				description += std::string(", ") + room_flag_names[flag];
+		return description;
+	}
+
+	std::vector<solver_node_type> nodes;
+	std::vector<std::vector<uint32_t>> predecessors;
+	std::unordered_map<solver_key_type, uint32_t, solver_key_hash_type> node_ids;
+	uint32_t edge_count;
+	uint32_t win_node;
+	solver_edge_type win_edge;
+};
+
+// Builds plain events one after another, as "Continue" does, and goes back
+// through them, checking each step against a list of what was shown. The
+// history can go back EVENT_HISTORY_DEPTH handles and the whole event before
+// the current one, and no further, however deep the events nest.
+class event_history_check_type {
+public:
+	event_history_check_type()
+	: reachable( 0 )
+	, steps( 0 )
+	, failures( 0 )
+	{ }
+
+	void start(){
+		setup();
+		game_presenter.init();
+		shown.push_back(current_handle());
+	}
+
+	// Each event shows a room's description, so it has lines to scroll.
+	void nest(uint16_t levels){
+		for (uint16_t i = 0; i < levels; i++){
+			uint16_t level = shown.size();
+			build_event<event>(game_presenter.load_new_event(), pgm_read_word(&rooms[level % ROOM_COUNT].description));
+			game_presenter.switch_to_event();
+			game_screen.set_scroll_position(level % SOLVER_HISTORY_SCROLL_SPAN);
+			if (reachable <= EVENT_HISTORY_DEPTH)
+				reachable++;
+			shown.push_back(current_handle());
+			check();
+		}
+	}
+
+	// Going back past the oldest event kept leaves the screen as it is.
+	void unwind(uint16_t levels){
+		for (uint16_t i = 0; i < levels; i++){
+			game_presenter.load_previous_event();
+			game_presenter.switch_to_event();
+			if (reachable > 0){
+				reachable--;
+				shown.pop_back();
+			}
+			check();
+		}
+	}
+
+	void report(){
+		printf("%u of %u event history steps wrong\n", failures, steps);
+	}
+
+	bool has_failures(){
+		return failures > 0;
+	}
+
+private:
+	std::vector<event_handle_type> shown;
+	uint8_t reachable;
+	uint16_t steps;
+	uint16_t failures;
+
+	static event_handle_type current_handle(){
+		return game_presenter.get_current_event().get_handle(game_screen.get_scroll_position());
+	}
+
+	void check(){
+		event_handle_type expected = shown.back();
+		event_handle_type actual = current_handle();
+		steps++;
+		if (actual.get_type() != expected.get_type()
+			|| actual.get_data() != expected.get_data()
+			|| actual.get_scroll_position() != expected.get_scroll_position()
+			|| game_presenter.history_length != reachable)
+			failures++;
+	}
+};
+
+int main(int argc, char **argv){
+	long worker_count = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+	if (worker_count < 1)
+		worker_count = 1;
+
+	// The game starts where a new game does, after the intro.
+	event slots[EVENT_MEMORY];
+	solver_key_type start_state;
+	build_event<starting_event>(slots[0]);
+	follow_events(slots, 0, start_state);
+
+	solver_worker_pool_type pool;
+	pool.start(worker_count);
+
+	solver_clock::time_point started = solver_clock::now();
+	solver_type solver;
+	solver.search(start_state, pool);
+	double elapsed_ms = std::chrono::duration<double, std::milli>(solver_clock::now() - started).count();
+	pool.stop();
+
+	printf("searched in %.1f ms on %ld workers\n", elapsed_ms, worker_count);
+	solver.report();
+
+	// Nests past the end of the history, goes part way back, so the ring
+	// wraps backwards, nests again, and then goes back as far as it can.
+	event_history_check_type history_check;
+	history_check.start();
+	history_check.nest(SOLVER_HISTORY_LEVELS);
+	history_check.unwind(EVENT_HISTORY_DEPTH / 2);
+	history_check.nest(EVENT_HISTORY_DEPTH);
+	history_check.unwind(SOLVER_HISTORY_LEVELS);
+	history_check.report();
+
+	return solver.can_win() && !solver.has_cut_short_descriptions() && !history_check.has_failures() ? 0 : 1;
+}
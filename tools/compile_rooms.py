@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+#
+# Dark Tower
+# Copyright (C) 2018 Marcus Hutchings
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+"""Compile the room descriptions into PROGMEM tables.
+
+usage: compile_rooms.py DarkTowerRooms.txt DarkTowerText.txt DarkTowerRooms.h
+
+Each room gets a ROOM_ID_<NAME>, in the order the rooms are listed, and a row
+in rooms[] pointing at its objects in room_objects[]. Texts are referred to by
+their names in DarkTowerText.txt, which are checked here. Each flag a room
+keeps between visits gets a ROOM_FLAG_<ROOM>_<FLAG>, numbering the bits of the
+room state from 0 across all the rooms.
+"""
+
+import collections
+import re
+import sys
+
+from compress_text import read_texts
+
+NAME_PATTERN = re.compile(r'^[a-z][a-z0-9_]*$')
+OBJECT_FIELDS = ('look', 'use', 'take', 'exit')
+MAX_ROOMS = 0xff
+MAX_OBJECTS_PER_ROOM = 10
+
+
+class room_type(object):
+	def __init__(self, name, line_number):
+		self.name = name
+		self.line_number = line_number
+		self.description = None
+		self.objects = []
+		self.flags = []
+
+
+def fail(path, line_number, message):
+	sys.exit('%s:%d: %s' % (path, line_number, message))
+
+
+def read_rooms(path, texts):
+	rooms = collections.OrderedDict()
+	cur_room = None
+
+	def check_text(line_number, name):
+		if name not in texts:
+			fail(path, line_number, 'no text called %s' % name)
+		return name
+
+	with open(path) as source:
+		for line_number, line in enumerate(source, 1):
+			words = line.split('#', 1)[0].split()
+			if not words:
+				continue
+			keyword, arguments = words[0], words[1:]
+
+			if keyword == 'room':
+				if len(arguments) != 1 or not NAME_PATTERN.match(arguments[0]):
+					fail(path, line_number, 'expected  room <name>')
+				if arguments[0] in rooms:
+					fail(path, line_number, 'room %s is defined twice' % arguments[0])
+				cur_room = room_type(arguments[0], line_number)
+				rooms[cur_room.name] = cur_room
+				continue
+
+			if cur_room is None:
+				fail(path, line_number, '%s outside a room' % keyword)
+
+			if keyword == 'description':
+				if len(arguments) != 1:
+					fail(path, line_number, 'expected  description <text>')
+				cur_room.description = check_text(line_number, arguments[0])
+			elif keyword == 'flag':
+				if len(arguments) != 1 or not NAME_PATTERN.match(arguments[0]):
+					fail(path, line_number, 'expected  flag <name>')
+				if arguments[0] in cur_room.flags:
+					fail(path, line_number, 'flag %s is defined twice' % arguments[0])
+				cur_room.flags.append(arguments[0])
+			elif keyword == 'object':
+				if len(arguments) % 2 != 1:
+					fail(path, line_number, 'expected  object <text> [<field> <value>]...')
+				room_object = {'name': check_text(line_number, arguments[0]), 'line_number': line_number}
+				for field, value in zip(arguments[1::2], arguments[2::2]):
+					if field not in OBJECT_FIELDS or field in room_object:
+						fail(path, line_number, 'unexpected %s' % field)
+					room_object[field] = value if field == 'exit' else check_text(line_number, value)
+				cur_room.objects.append(room_object)
+				if len(cur_room.objects) > MAX_OBJECTS_PER_ROOM:
+					fail(path, line_number, 'more than %d objects' % MAX_OBJECTS_PER_ROOM)
+			else:
+				fail(path, line_number, 'unknown keyword %s' % keyword)
+
+	for room in rooms.values():
+		if room.description is None:
+			fail(path, room.line_number, 'room %s has no description' % room.name)
+		for room_object in room.objects:
+			if room_object.get('exit', room.name) not in rooms:
+				fail(path, room_object['line_number'], 'no room called %s' % room_object['exit'])
+	if len(rooms) > MAX_ROOMS:
+		sys.exit('%s: more than %d rooms' % (path, MAX_ROOMS))
+	return rooms
+
+
+def flag_constant(room, flag):
+	return 'ROOM_FLAG_%s_%s' % (room.name.upper(), flag.upper())
+
+
+def text_constant(name):
+	return 'TEXT_%s' % name.upper() if name else 'TEXT_NONE'
+
+
+def room_constant(name):
+	return 'ROOM_ID_%s' % name.upper() if name else 'ROOM_ID_NONE'
+
+
+def write_header(path, rooms):
+	out = []
+	out.append('/*')
+	out.append(' * Dark Tower')
+	out.append(' * Copyright (C) 2018 Marcus Hutchings')
+	out.append(' *')
+	out.append(' * This program is free software: you can redistribute it and/or modify')
+	out.append(' * it under the terms of the GNU General Public License as published by')
+	out.append(' * the Free Software Foundation, either version 3 of the License, or')
+	out.append(' * (at your option) any later version.')
+	out.append(' *')
+	out.append(' * This program is distributed in the hope that it will be useful,')
+	out.append(' * but WITHOUT ANY WARRANTY; without even the implied warranty of')
+	out.append(' * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the')
+	out.append(' * GNU General Public License for more details.')
+	out.append(' *')
+	out.append(' * You should have received a copy of the GNU General Public License')
+	out.append(' * along with this program.  If not, see <https://www.gnu.org/licenses/>.')
+	out.append(' */')
+	out.append('')
+	out.append('// Generated from DarkTowerRooms.txt by tools/compile_rooms.py. Do not edit.')
+	out.append('')
+	out.append('#ifndef DARK_TOWER_ROOMS_H')
+	out.append('#define DARK_TOWER_ROOMS_H')
+	out.append('')
+	out.append('typedef uint8_t room_id;')
+	out.append('')
+	out.append('#define ROOM_ID_NONE 0x%02x' % MAX_ROOMS)
+	for index, name in enumerate(rooms):
+		out.append('#define %s %d' % (room_constant(name), index))
+	out.append('#define ROOM_COUNT %d' % len(rooms))
+	out.append('')
+	out.append('#define ROOM_MAX_OBJECTS %d' % MAX_OBJECTS_PER_ROOM)
+	out.append('')
+	flag_count = 0
+	for room in rooms.values():
+		for flag in room.flags:
+			out.append('#define %s %d' % (flag_constant(room, flag), flag_count))
+			flag_count += 1
+	out.append('#define ROOM_FLAG_COUNT %d' % flag_count)
+	out.append('')
+	out.append('struct room_type')
+	out.append('{')
+	out.append('\ttext_id description;')
+	out.append('\tuint16_t first_object;')
+	out.append('\tuint8_t object_count;')
+	out.append('};')
+	out.append('')
+	out.append('// A missing text is TEXT_NONE, and an object that leads nowhere has ROOM_ID_NONE.')
+	out.append('struct room_object_type')
+	out.append('{')
+	out.append('\ttext_id name;')
+	out.append('\ttext_id look;')
+	out.append('\ttext_id use;')
+	out.append('\ttext_id take;')
+	out.append('\troom_id exit;')
+	out.append('};')
+	out.append('')
+	out.append('const room_type rooms[ROOM_COUNT] PROGMEM =')
+	first_object = 0
+	for index, room in enumerate(rooms.values()):
+		out.append('\t%s { %s, %d, %d } // %s' % ('{' if index == 0 else ',', text_constant(room.description), first_object, len(room.objects), room.name))
+		first_object += len(room.objects)
+	out.append('\t};')
+	out.append('')
+	out.append('const room_object_type room_objects[] PROGMEM =')
+	index = 0
+	for room in rooms.values():
+		out.append('\t// %s' % room.name)
+		for room_object in room.objects:
+			fields = [text_constant(room_object['name'])]
+			fields += [text_constant(room_object.get(field)) for field in OBJECT_FIELDS[:-1]]
+			fields.append(room_constant(room_object.get('exit')))
+			out.append('\t%s { %s }' % ('{' if index == 0 else ',', ', '.join(fields)))
+			index += 1
+	out.append('\t};')
+	out.append('')
+	out.append('#ifdef DARK_TOWER_ROOM_NAMES')
+	out.append('// Room and flag names, for tools built on the host.')
+	out.append('const char *const room_names[ROOM_COUNT] =')
+	for index, name in enumerate(rooms):
+		out.append('\t%s "%s"' % ('{' if index == 0 else ',', name))
+	out.append('\t};')
+	if flag_count > 0:
+		out.append('')
+		out.append('const char *const room_flag_names[ROOM_FLAG_COUNT] =')
+		index = 0
+		for room in rooms.values():
+			for flag in room.flags:
+				out.append('\t%s "%s.%s"' % ('{' if index == 0 else ',', room.name, flag))
+				index += 1
+		out.append('\t};')
+	out.append('#endif')
+	out.append('')
+	out.append('#endif')
+
+	with open(path, 'w') as header:
+		header.write('\n'.join(out) + '\n')
+
+
+def main(argv):
+	if len(argv) != 4:
+		sys.exit(__doc__.strip().splitlines()[2])
+
+	texts = read_texts(argv[2])
+	rooms = read_rooms(argv[1], texts)
+	write_header(argv[3], rooms)
+
+	object_count = sum(len(room.objects) for room in rooms.values())
+	flag_count = sum(len(room.flags) for room in rooms.values())
+	print('%d rooms, %d objects, %d flags' % (len(rooms), object_count, flag_count))
+
+
+if __name__ == '__main__':
+	main(sys.argv)
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+#
+# Dark Tower
+# Copyright (C) 2018 Marcus Hutchings
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+"""Compress the game text into a PROGMEM header.
+
+usage: compress_text.py DarkTowerText.txt DarkTowerText.h
+
+Each text is split into words on single spaces, and the words worth sharing
+go into a dictionary. A text is then stored as a stream of byte codes, one per
+word, with the space between words left implied:
+
+  0x00          end of text
+  0x01 - 0x3f   a word of that many characters, which follow
+  0x40          an empty word, for an extra, leading or trailing space
+  0x41 - 0xef   dictionary word 0 - 174
+  0xf0 - 0xff   dictionary word 175 onwards, with the low nibble and the next
+                byte as the high and low bytes of (index - 175)
+
+The decoder in DarkTower.cpp reads the same codes; the constants are written
+into the header so the two cannot drift apart.
+"""
+
+import collections
+import re
+import sys
+
+CODE_END = 0x00
+CODE_LITERAL_MAX = 0x3f
+CODE_EMPTY_WORD = 0x40
+CODE_WORD = 0x41
+CODE_LONG_WORD = 0xf0
+SHORT_WORD_CODES = CODE_LONG_WORD - CODE_WORD
+MAX_WORDS = SHORT_WORD_CODES + 0x1000
+
+# Never a valid offset, since the streams must stay below it.
+TEXT_NONE = 0xffff
+
+# Bytes the dictionary spends on each entry besides its characters.
+DICTIONARY_ENTRY_OVERHEAD = 2
+
+LINE_PATTERN = re.compile(r'^([a-z][a-z0-9_]*)\s*=\s*"([^"\\]*)"$')
+
+
+def read_texts(path):
+	texts = collections.OrderedDict()
+	with open(path) as source:
+		for line_number, line in enumerate(source, 1):
+			line = line.rstrip('\n')
+			if not line.strip() or line.lstrip().startswith('#'):
+				continue
+			match = LINE_PATTERN.match(line)
+			if match is None:
+				sys.exit('%s:%d: expected  name = "text"' % (path, line_number))
+			name, text = match.groups()
+			if name in texts:
+				sys.exit('%s:%d: %s is defined twice' % (path, line_number, name))
+			if any(ord(c) < 0x20 or ord(c) > 0x7e for c in text):
+				sys.exit('%s:%d: only printable ASCII is supported' % (path, line_number))
+			texts[name] = text
+	return texts
+
+
+def choose_dictionary(unique_texts):
+	counts = collections.Counter()
+	for text in unique_texts:
+		counts.update(word for word in text.split(' ') if word)
+
+	def savings(word, code_size):
+		literal = counts[word] * (1 + len(word))
+		shared = len(word) + DICTIONARY_ENTRY_OVERHEAD + counts[word] * code_size
+		return literal - shared
+
+	# One-byte codes go to the most used words, since each use saves a byte
+	# over a two-byte code.
+	candidates = sorted(counts, key=lambda word: (-counts[word], -len(word), word))
+	short_words = [word for word in candidates if savings(word, 1) > 0][:SHORT_WORD_CODES]
+	long_words = [word for word in candidates if word not in short_words and savings(word, 2) > 0]
+	return (short_words + long_words)[:MAX_WORDS]
+
+
+def encode(text, word_index):
+	codes = []
+	for word in text.split(' '):
+		if not word:
+			codes.append(CODE_EMPTY_WORD)
+		elif word in word_index:
+			index = word_index[word]
+			if index < SHORT_WORD_CODES:
+				codes.append(CODE_WORD + index)
+			else:
+				index -= SHORT_WORD_CODES
+				codes += [CODE_LONG_WORD + (index >> 8), index & 0xff]
+		else:
+			if len(word) > CODE_LITERAL_MAX:
+				sys.exit('word too long to store: %s' % word)
+			codes.append(len(word))
+			codes += [ord(c) for c in word]
+	codes.append(CODE_END)
+	return codes
+
+
+def c_string(text):
+	return '"%s"' % text.replace('\\', '\\\\').replace('"', '\\"')
+
+
+def write_header(path, texts, unique_texts, dictionary, streams, offsets):
+	dictionary_offsets = [0]
+	for word in dictionary:
+		dictionary_offsets.append(dictionary_offsets[-1] + len(word))
+
+	out = []
+	out.append('/*')
+	out.append(' * Dark Tower')
+	out.append(' * Copyright (C) 2018 Marcus Hutchings')
+	out.append(' *')
+	out.append(' * This program is free software: you can redistribute it and/or modify')
+	out.append(' * it under the terms of the GNU General Public License as published by')
+	out.append(' * the Free Software Foundation, either version 3 of the License, or')
+	out.append(' * (at your option) any later version.')
+	out.append(' *')
+	out.append(' * This program is distributed in the hope that it will be useful,')
+	out.append(' * but WITHOUT ANY WARRANTY; without even the implied warranty of')
+	out.append(' * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the')
+	out.append(' * GNU General Public License for more details.')
+	out.append(' *')
+	out.append(' * You should have received a copy of the GNU General Public License')
+	out.append(' * along with this program.  If not, see <https://www.gnu.org/licenses/>.')
+	out.append(' */')
+	out.append('')
+	out.append('// Generated from DarkTowerText.txt by tools/compress_text.py. Do not edit.')
+	out.append('')
+	out.append('#ifndef DARK_TOWER_TEXT_H')
+	out.append('#define DARK_TOWER_TEXT_H')
+	out.append('')
+	out.append('// A handle to a compressed text: its offset in text_streams.')
+	out.append('typedef uint16_t text_id;')
+	out.append('')
+	out.append('#define TEXT_NONE ((text_id)0x%04x)' % TEXT_NONE)
+	out.append('')
+	out.append('#define TEXT_CODE_END 0x%02x' % CODE_END)
+	out.append('#define TEXT_CODE_LITERAL_MAX 0x%02x' % CODE_LITERAL_MAX)
+	out.append('#define TEXT_CODE_EMPTY_WORD 0x%02x' % CODE_EMPTY_WORD)
+	out.append('#define TEXT_CODE_WORD 0x%02x' % CODE_WORD)
+	out.append('#define TEXT_CODE_LONG_WORD 0x%02x' % CODE_LONG_WORD)
+	out.append('#define TEXT_SHORT_WORD_CODES (TEXT_CODE_LONG_WORD - TEXT_CODE_WORD)')
+	out.append('')
+	out.append('#define TEXT_DICTIONARY_SIZE %d' % len(dictionary))
+	out.append('')
+	out.append('const char text_dictionary[] PROGMEM =')
+	for start in range(0, len(dictionary), 8):
+		out.append('\t' + ' '.join(c_string(word) for word in dictionary[start:start + 8]))
+	out.append('\t;')
+	out.append('')
+	out.append('const uint16_t text_dictionary_offsets[TEXT_DICTIONARY_SIZE + 1] PROGMEM = {')
+	for start in range(0, len(dictionary_offsets), 12):
+		out.append('\t' + ' '.join('%d,' % offset for offset in dictionary_offsets[start:start + 12]))
+	out.append('};')
+	out.append('')
+	out.append('const uint8_t text_streams[] PROGMEM = {')
+	for text, codes in zip(unique_texts, streams):
+		out.append('\t// %s' % c_string(text if len(text) <= 60 else text[:57] + '...'))
+		for start in range(0, len(codes), 16):
+			out.append('\t' + ' '.join('0x%02x,' % code for code in codes[start:start + 16]))
+	out.append('};')
+	out.append('')
+	for name, text in texts.items():
+		out.append('#define TEXT_%s ((text_id)%d)' % (name.upper(), offsets[text]))
+	out.append('')
+	out.append('#ifdef DARK_TOWER_TEXT_NAMES')
+	out.append('// Every text by name, for tools built on the host.')
+	out.append('struct text_name_type')
+	out.append('{')
+	out.append('\tconst char *name;')
+	out.append('\ttext_id text;')
+	out.append('};')
+	out.append('')
+	out.append('#define TEXT_NAME_COUNT %d' % len(texts))
+	out.append('')
+	out.append('const text_name_type text_names[TEXT_NAME_COUNT] =')
+	for index, name in enumerate(texts):
+		out.append('\t%s { %s, TEXT_%s }' % ('{' if index == 0 else ',', c_string(name), name.upper()))
+	out.append('\t};')
+	out.append('#endif')
+	out.append('')
+	out.append('#endif')
+
+	with open(path, 'w') as header:
+		header.write('\n'.join(out) + '\n')
+
+
+def main(argv):
+	if len(argv) != 3:
+		sys.exit(__doc__.strip().splitlines()[2])
+
+	texts = read_texts(argv[1])
+	unique_texts = list(collections.OrderedDict.fromkeys(texts.values()))
+	dictionary = choose_dictionary(unique_texts)
+	word_index = dict((word, index) for index, word in enumerate(dictionary))
+
+	streams = []
+	offsets = {}
+	stream_size = 0
+	for text in unique_texts:
+		codes = encode(text, word_index)
+		offsets[text] = stream_size
+		stream_size += len(codes)
+		streams.append(codes)
+
+	if stream_size >= TEXT_NONE:
+		sys.exit('%s: too much text for 16-bit text ids' % argv[1])
+
+	write_header(argv[2], texts, unique_texts, dictionary, streams, offsets)
+
+	raw_size = sum(len(text) + 1 for text in texts.values())
+	dictionary_size = sum(len(word) + DICTIONARY_ENTRY_OVERHEAD for word in dictionary) + DICTIONARY_ENTRY_OVERHEAD
+	print('%d texts, %d bytes as strings; %d bytes compressed (%d of streams, %d words in %d bytes of dictionary)'
+		% (len(texts), raw_size, stream_size + dictionary_size, stream_size, len(dictionary), dictionary_size))
+
+
+if __name__ == '__main__':
+	main(sys.argv)
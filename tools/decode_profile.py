@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+#
+# Dark Tower
+# Copyright (C) 2018 Marcus Hutchings
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+"""Print the profile reports a DARK_TOWER_PROFILE build sends over Serial.
+
+usage: decode_profile.py DarkTower.cpp capture
+
+The capture is the raw bytes read from the serial port. The section names are
+read from the PROFILE_SECTION_ constants in the sketch, so the two cannot
+drift apart. Each report is printed as it was sent, followed by the totals of
+all of them. Bytes before a report, such as a report cut short when the
+capture started, are skipped.
+"""
+
+import re
+import struct
+import sys
+
+REPORT_MAGIC = b'DTP1'
+SECTION_PATTERN = re.compile(r'^#define PROFILE_SECTION_([A-Z_]+) (\d+)$', re.MULTILINE)
+BAR_WIDTH = 40
+
+
+class report_type(object):
+	def __init__(self, frames, bucket_cycles, buckets, sections):
+		self.frames = frames
+		self.bucket_cycles = bucket_cycles
+		self.buckets = buckets
+		# A list of (calls, min, max, total) for each section.
+		self.sections = sections
+
+	def add(self, other):
+		self.frames += other.frames
+		self.buckets = [mine + theirs for mine, theirs in zip(self.buckets, other.buckets)]
+		sections = []
+		for mine, theirs in zip(self.sections, other.sections):
+			if mine[0] == 0 or theirs[0] == 0:
+				sections.append(mine if theirs[0] == 0 else theirs)
+			else:
+				sections.append((mine[0] + theirs[0], min(mine[1], theirs[1]), max(mine[2], theirs[2]), mine[3] + theirs[3]))
+		self.sections = sections
+
+
+def read_section_names(path):
+	with open(path) as sketch:
+		names = dict((int(index), name.lower()) for name, index in SECTION_PATTERN.findall(sketch.read()) if name != 'COUNT')
+	if not names:
+		sys.exit('%s: no PROFILE_SECTION_ constants' % path)
+	return names
+
+
+def read_reports(data):
+	reports = []
+	position = data.find(REPORT_MAGIC)
+	while position >= 0:
+		try:
+			offset = position + len(REPORT_MAGIC)
+			frames, bucket_cycles, bucket_count = struct.unpack_from('<HIB', data, offset)
+			offset += 7
+			buckets = list(struct.unpack_from('<%dH' % bucket_count, data, offset))
+			offset += 2 * bucket_count
+			section_count, = struct.unpack_from('<B', data, offset)
+			offset += 1
+			sections = []
+			for i in range(section_count):
+				sections.append(struct.unpack_from('<HIII', data, offset))
+				offset += 14
+		except struct.error:
+			break
+		reports.append(report_type(frames, bucket_cycles, buckets, sections))
+		position = data.find(REPORT_MAGIC, offset)
+	return reports
+
+
+def print_report(title, report, names):
+	print('%s: %d frames' % (title, report.frames))
+	print('  %-16s %8s %10s %10s %10s' % ('section (cycles)', 'calls', 'min', 'avg', 'max'))
+	for index, (calls, low, high, total) in enumerate(report.sections):
+		name = names.get(index, 'section %d' % index)
+		if calls == 0:
+			print('  %-16s %8d' % (name, 0))
+		else:
+			print('  %-16s %8d %10d %10d %10d' % (name, calls, low, total // calls, high))
+
+	print('  frame time (cycles)')
+	most = max(report.buckets) if report.buckets else 0
+	for index, count in enumerate(report.buckets):
+		low = index * report.bucket_cycles
+		if index == len(report.buckets) - 1:
+			label = '%d and over' % low
+		else:
+			label = '%d - %d' % (low, low + report.bucket_cycles - 1)
+		bar = '#' * (count * BAR_WIDTH // most) if most else ''
+		print('  %24s %6d %s' % (label, count, bar))
+
+
+def main(argv):
+	if len(argv) != 3:
+		sys.exit(__doc__.strip().splitlines()[2])
+
+	names = read_section_names(argv[1])
+	with open(argv[2], 'rb') as capture:
+		reports = read_reports(capture.read())
+	if not reports:
+		sys.exit('%s: no profile reports' % argv[2])
+
+	total = None
+	for number, report in enumerate(reports, 1):
+		print_report('report %d' % number, report, names)
+		print('')
+		if total is None:
+			total = report_type(0, report.bucket_cycles, [0] * len(report.buckets), [(0, 0, 0, 0)] * len(report.sections))
+		total.add(report)
+	print_report('all %d reports' % len(reports), total, names)
+
+
+if __name__ == '__main__':
+	main(sys.argv)